@@ -0,0 +1,431 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "benchmark.h"
+
+#include <algorithm>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QPair>
+#include <QtCore/QStringList>
+#include <QtCore/QThread>
+
+#include <QtGui/QImage>
+#include <QtGui/QImageReader>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include "imageProcessing.h"
+#include "imageUtility.h"
+#include "colorLists.h"
+#include "colorDistance.h"
+#include "flossPalette.h"
+#include "grid.h"
+#include "kMeans.h"
+
+// a kernel is repeated until it has run at least BENCHMARK_MIN_ITERATIONS
+// times for a total of at least BENCHMARK_MIN_TOTAL_MS, or until it has
+// run BENCHMARK_MAX_ITERATIONS times
+const int BENCHMARK_MIN_ITERATIONS = 3;
+const int BENCHMARK_MAX_ITERATIONS = 100;
+const qint64 BENCHMARK_MIN_TOTAL_MS = 250;
+// the number of colors to choose for the color choosing kernels
+const int BENCHMARK_NUM_COLORS = 32;
+// matching every color of a photograph against the dmc list takes far too
+// long, so rgbToDmc only gets (up to) this many of the image's colors
+const int BENCHMARK_MAX_MATCH_COLORS = 4096;
+
+// the sizes of the synthetic images
+static QList<QSize> syntheticSizes() {
+
+  QList<QSize> sizes;
+  sizes << QSize(256, 256) << QSize(1024, 768) << QSize(1600, 1200);
+  return sizes;
+}
+
+// the square dimensions to run the square kernels at
+static QList<int> squareDimensions() {
+
+  QList<int> dimensions;
+  dimensions << 4 << 8 << 16;
+  return dimensions;
+}
+
+// benchmarkTimer collects the timings of repeated runs of one kernel.
+// Usage:
+//   benchmarkTimer timer;
+//   while (timer.more()) {
+//     [untimed setup]
+//     timer.start();
+//     [kernel]
+//     timer.stop();
+//   }
+class benchmarkTimer {
+
+ public:
+  benchmarkTimer() : total_(0) {}
+  // return true if the kernel should be run again
+  bool more() const {
+    const int runs = runs_.size();
+    return runs < BENCHMARK_MIN_ITERATIONS ||
+      (runs < BENCHMARK_MAX_ITERATIONS &&
+       total_ < BENCHMARK_MIN_TOTAL_MS * 1000000);
+  }
+  void start() { timer_.start(); }
+  void stop() {
+    const qint64 elapsed = timer_.nsecsElapsed();
+    runs_.push_back(elapsed);
+    total_ += elapsed;
+  }
+  // return the json record for these runs of <kernel> on the <image> of
+  // <imageSize> at square <dimension> (0 if the kernel doesn't square)
+  QJsonObject result(const QString& kernel, const QString& image,
+                     const QSize& imageSize, int dimension) const;
+
+ private:
+  QElapsedTimer timer_;
+  QVector<qint64> runs_; // nanoseconds
+  qint64 total_; // nanoseconds
+};
+
+QJsonObject benchmarkTimer::result(const QString& kernel,
+                                   const QString& image,
+                                   const QSize& imageSize,
+                                   int dimension) const {
+
+  QVector<qint64> runs = runs_;
+  std::sort(runs.begin(), runs.end());
+  const qreal nsPerMs = 1000000.;
+  QJsonObject object;
+  object["kernel"] = kernel;
+  object["image"] = image;
+  object["width"] = imageSize.width();
+  object["height"] = imageSize.height();
+  if (dimension) {
+    object["dimension"] = dimension;
+  }
+  object["iterations"] = runs.size();
+  object["min_ms"] = runs.first()/nsPerMs;
+  object["median_ms"] = runs[runs.size()/2]/nsPerMs;
+  object["mean_ms"] = total_/nsPerMs/runs.size();
+  return object;
+}
+
+// return a deterministic test image of <size>: smooth gradients with
+// some hard edged blocks and a little noise, so that the kernels see both
+// gradual and abrupt color changes and a realistic number of colors
+static QImage syntheticImage(const QSize& size) {
+
+  QImage image(size, QImage::Format_RGB32);
+  const int width = size.width();
+  const int height = size.height();
+  quint32 seed = 12345;
+  for (int j = 0; j < height; ++j) {
+    QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(j));
+    for (int i = 0; i < width; ++i) {
+      seed = seed * 1103515245 + 12345;
+      const int noise = static_cast<int>((seed >> 16) % 17) - 8;
+      int red = 255 * i/width;
+      int green = 255 * j/height;
+      int blue = 255 * (i + j)/(width + height);
+      if ((i/64 + j/64) % 5 == 0) {
+        red = 255 - red;
+        blue = 64;
+      }
+      line[i] = qRgb(qBound(0, red + noise, 255),
+                     qBound(0, green + noise, 255),
+                     qBound(0, blue + noise, 255));
+    }
+  }
+  return image;
+}
+
+// run all of the kernels on <sourceImage> (named <name>) and append the
+// results to <results>
+static void benchmarkImage(const QString& name, const QImage& sourceImage,
+                           QJsonArray* results) {
+
+  const QImage image = sourceImage.convertToFormat(QImage::Format_RGB32);
+  const QSize size = image.size();
+
+  int numImageColors = 0;
+  benchmarkTimer countTimer;
+  while (countTimer.more()) {
+    countTimer.start();
+    numImageColors = ::numberOfColors(image);
+    countTimer.stop();
+  }
+  results->append(countTimer.result("numberOfColors", name, size, 0));
+
+  const colorTransformerPtr transformer =
+    colorTransformer::createColorTransformer(flossVariable);
+  QVector<triC> colors;
+  benchmarkTimer chooseTimer;
+  while (chooseTimer.more()) {
+    chooseTimer.start();
+    colors = ::chooseColors(image, BENCHMARK_NUM_COLORS, QVector<triC>(),
+                            numImageColors, transformer);
+    chooseTimer.stop();
+  }
+  results->append(chooseTimer.result("chooseColors", name, size, 0));
+
+  benchmarkTimer kMeansTimer;
+  while (kMeansTimer.more()) {
+    QVector<triC> centroids;
+    kMeansTimer.start();
+    ::kMeansColors(image, BENCHMARK_NUM_COLORS, QVector<triC>(),
+                   QVector<triC>(), transformer, &centroids);
+    kMeansTimer.stop();
+  }
+  results->append(kMeansTimer.result("kMeansColors", name, size, 0));
+
+  QHash<QRgb, int> colorCounts;
+  for (int j = 0; j < size.height(); ++j) {
+    for (int i = 0; i < size.width(); ++i) {
+      ++colorCounts[image.pixel(i, j)];
+    }
+  }
+  benchmarkTimer listTimer;
+  while (listTimer.more()) {
+    listTimer.start();
+    ::chooseColorsFromList(colorCounts, QVector<QRgb>(),
+                           BENCHMARK_NUM_COLORS, transformer);
+    listTimer.stop();
+  }
+  results->append(listTimer.result("chooseColorsFromList", name, size, 0));
+
+  QVector<triC> imageColors;
+  for (QHash<QRgb, int>::const_iterator it = colorCounts.begin(),
+         end = colorCounts.end();
+       it != end && imageColors.size() < BENCHMARK_MAX_MATCH_COLORS; ++it) {
+    imageColors.push_back(it.key());
+  }
+  benchmarkTimer dmcTimer;
+  while (dmcTimer.more()) {
+    dmcTimer.start();
+    ::rgbToDmc(imageColors);
+    dmcTimer.stop();
+  }
+  results->append(dmcTimer.result("rgbToDmc", name, size, 0));
+
+  QImage segmented;
+  benchmarkTimer segmentTimer;
+  while (segmentTimer.more()) {
+    segmented = image.copy();
+    segmentTimer.start();
+    ::segment(&segmented, colors, numImageColors);
+    segmentTimer.stop();
+  }
+  results->append(segmentTimer.result("segment", name, size, 0));
+
+  // the same matching with each Lab metric; rgbToDmc is timed both with
+  // the palettes' match tables cleared before each run (cold) and with
+  // them filled by the earlier runs (warm)
+  const colorMetric labMetrics[] = {metricCie76, metricCiede2000};
+  for (int m = 0; m < 2; ++m) {
+    const colorMetricScope metricScope(labMetrics[m]);
+    const QString metricName =
+      " (" + colorDistance::metricToString(labMetrics[m]) + ")";
+    benchmarkTimer coldDmcTimer;
+    while (coldDmcTimer.more()) {
+      paletteRegistry::clearLabTables();
+      coldDmcTimer.start();
+      ::rgbToDmc(imageColors);
+      coldDmcTimer.stop();
+    }
+    results->append(coldDmcTimer.result("rgbToDmc cold" + metricName, name,
+                                        size, 0));
+
+    benchmarkTimer labDmcTimer;
+    while (labDmcTimer.more()) {
+      labDmcTimer.start();
+      ::rgbToDmc(imageColors);
+      labDmcTimer.stop();
+    }
+    results->append(labDmcTimer.result("rgbToDmc" + metricName, name, size,
+                                       0));
+
+    benchmarkTimer labSegmentTimer;
+    while (labSegmentTimer.more()) {
+      segmented = image.copy();
+      labSegmentTimer.start();
+      ::segment(&segmented, colors, numImageColors);
+      labSegmentTimer.stop();
+    }
+    results->append(labSegmentTimer.result("segment" + metricName, name,
+                                           size, 0));
+  }
+  // (leave the tables for the next image cold too)
+  paletteRegistry::clearLabTables();
+
+  const QList<int> dimensions = squareDimensions();
+  for (int d = 0, dSize = dimensions.size(); d < dSize; ++d) {
+    const int dimension = dimensions[d];
+    const int xSquares = size.width()/dimension;
+    const int ySquares = size.height()/dimension;
+    if (xSquares == 0 || ySquares == 0) {
+      continue;
+    }
+    // the square kernels expect whole squares
+    const QRect squaresRect(0, 0, xSquares * dimension,
+                            ySquares * dimension);
+    const QImage original = image.copy(squaresRect);
+    const QImage newImage = segmented.copy(squaresRect);
+
+    QImage squared;
+    benchmarkTimer modeTimer;
+    while (modeTimer.more()) {
+      squared = newImage.copy();
+      modeTimer.start();
+      ::mode(&squared, dimension);
+      modeTimer.stop();
+    }
+    results->append(modeTimer.result("mode", name, size, dimension));
+
+    const grid originalGrid(original);
+    benchmarkTimer gridMedianTimer;
+    while (gridMedianTimer.more()) {
+      grid newGrid(newImage);
+      gridMedianTimer.start();
+      ::median(&newGrid, originalGrid, dimension);
+      gridMedianTimer.stop();
+    }
+    results->append(gridMedianTimer.result("median_grid", name, size,
+                                           dimension));
+
+    // rerun median on every square, with the mode colors as the old colors
+    QList<pixel> squaresList;
+    QVector<historyPixel> oldColors;
+    for (int y = 0; y < ySquares; ++y) {
+      for (int x = 0; x < xSquares; ++x) {
+        const pairOfInts coordinates(x, y);
+        squaresList.push_back(pixel(coordinates));
+        oldColors.push_back(historyPixel(pixel(squared.pixel(x * dimension,
+                                                             y * dimension),
+                                               coordinates)));
+      }
+    }
+    benchmarkTimer squaresMedianTimer;
+    while (squaresMedianTimer.more()) {
+      QImage squaresImage = newImage.copy();
+      squaresMedianTimer.start();
+      ::median(&squaresImage, original, squaresList, oldColors, dimension);
+      squaresMedianTimer.stop();
+    }
+    results->append(squaresMedianTimer.result("median_squares", name, size,
+                                              dimension));
+
+    // change the color of the top left square to some other image color
+    const QRgb oldColor = squared.pixel(0, 0);
+    QRgb newColor = qRgb(0, 0, 0) == oldColor ? qRgb(255, 255, 255) :
+      qRgb(0, 0, 0);
+    for (int i = 0, colorsSize = colors.size(); i < colorsSize; ++i) {
+      if (colors[i].qrgb() != oldColor) {
+        newColor = colors[i].qrgb();
+        break;
+      }
+    }
+    benchmarkTimer changeTimer;
+    while (changeTimer.more()) {
+      QImage changed = squared.copy();
+      changeTimer.start();
+      ::changeColor(&changed, oldColor, newColor, dimension);
+      changeTimer.stop();
+    }
+    results->append(changeTimer.result("changeColor", name, size,
+                                       dimension));
+
+    benchmarkTimer fillTimer;
+    while (fillTimer.more()) {
+      QImage filled = squared.copy();
+      fillTimer.start();
+      ::fillRegion(&filled, 0, 0, newColor, dimension);
+      fillTimer.stop();
+    }
+    results->append(fillTimer.result("fillRegion", name, size, dimension));
+  }
+}
+
+// run the benchmarks for the synthetic images and <images> (keyed by
+// name); run off of the gui thread so that the kernels' progress meters
+// stay hidden
+static QJsonArray
+benchmarkImages(const QList<QPair<QString, QImage> >& images) {
+
+  QJsonArray results;
+  const QList<QSize> sizes = syntheticSizes();
+  for (int i = 0, size = sizes.size(); i < size; ++i) {
+    benchmarkImage("synthetic", syntheticImage(sizes[i]), &results);
+  }
+  for (int i = 0, size = images.size(); i < size; ++i) {
+    benchmarkImage(images[i].first, images[i].second, &results);
+  }
+  return results;
+}
+
+int runBenchmarks(const QStringList& imageFiles, const QString& outputFile,
+                  const QString& programVersion) {
+
+  QList<QPair<QString, QImage> > images;
+  for (int i = 0, size = imageFiles.size(); i < size; ++i) {
+    QImageReader reader(imageFiles[i]);
+    const QImage image = reader.read();
+    if (image.isNull()) {
+      qWarning() << "Benchmark image load failed:" << imageFiles[i] <<
+        reader.errorString();
+      return 1;
+    }
+    images.push_back(qMakePair(QFileInfo(imageFiles[i]).fileName(), image));
+  }
+
+  // the kernels only read the color lists once they're loaded
+  colorMatcher::loadDataSources();
+  QFuture<QJsonArray> future = QtConcurrent::run(benchmarkImages, images);
+  future.waitForFinished();
+
+  QJsonObject root;
+  root["program_version"] = programVersion;
+  root["qt_version"] = QString(qVersion());
+  root["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+  root["thread_count"] = QThread::idealThreadCount();
+  root["benchmarks"] = future.result();
+
+  QFile output;
+  bool opened = false;
+  if (outputFile.isEmpty()) {
+    opened = output.open(stdout, QIODevice::WriteOnly);
+  }
+  else {
+    output.setFileName(outputFile);
+    opened = output.open(QIODevice::WriteOnly);
+  }
+  if (!opened || output.write(QJsonDocument(root).toJson()) == -1) {
+    qWarning() << "Benchmark output failed:" << outputFile <<
+      output.errorString();
+    return 1;
+  }
+  return 0;
+}
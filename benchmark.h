@@ -0,0 +1,40 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+class QString;
+class QStringList;
+
+// Time the image processing kernels (numberOfColors, chooseColors,
+// chooseColorsFromList, rgbToDmc, segment, mode, both medians, changeColor
+// and fillRegion) on synthetic images of several sizes and on the images
+// in <imageFiles>, at several square dimensions, and write the results as
+// JSON to <outputFile> (or to stdout if <outputFile> is empty).
+// rgbToDmc and segment are also timed with each Lab metric, and rgbToDmc
+// both with empty and with filled palette match tables.
+// The processing used is that of the current project version, which the
+// caller must have set.
+// Returns 0 on success, non-zero if an image couldn't be read or the
+// results couldn't be written.
+int runBenchmarks(const QStringList& imageFiles, const QString& outputFile,
+                  const QString& programVersion);
+
+#endif
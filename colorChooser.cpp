@@ -21,6 +21,8 @@
 
 #include <QtCore/qmath.h>
 #include <QtCore/QSettings>
+#include <QtCore/QTimer>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include <QtWidgets/QSpinBox>
 #include <QtWidgets/QScrollArea>
@@ -30,6 +32,7 @@
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QPushButton>
 #include <QtWidgets/QMessageBox>
+#include <QtWidgets/QActionGroup>
 
 #include "utility.h"
 #include "imageLabel.h"
@@ -42,12 +45,54 @@
 #include "symbolChooser.h" // for max number of colors(/symbols)
 #include "xmlUtility.h"
 #include "windowSavers.h"
+#include "colorLists.h"
+
+// the most pixels a preview proxy image has
+const int PREVIEW_PROXY_PIXELS = 320*320;
+// how long to wait after a change before starting a preview (ms)
+const int PREVIEW_DELAY = 150;
+
+// return <image> scaled down to at most PREVIEW_PROXY_PIXELS pixels
+// (nearest neighbor, so that the proxy only has original colors)
+static QImage createPreviewProxy(const QImage& image) {
+
+  const qreal scale =
+    qSqrt(static_cast<qreal>(PREVIEW_PROXY_PIXELS) /
+          (static_cast<qreal>(image.width()) * image.height()));
+  if (scale >= 1) {
+    return image.convertToFormat(QImage::Format_RGB32);
+  }
+  return image.scaled(qMax(1, qRound(image.width() * scale)),
+                      qMax(1, qRound(image.height() * scale)),
+                      Qt::IgnoreAspectRatio, Qt::FastTransformation).
+    convertToFormat(QImage::Format_RGB32);
+}
+
+// process <image> in <mode> with <settings> (run in the background)
+static previewResult processPreview(processModePtr mode, QImage image,
+                                    previewSettings settings) {
+
+  QVector<triC> generatedColors;
+  const bool completed =
+    mode->processImage(&image, settings.clickedColors(),
+                       settings.numColors(), 0, &generatedColors);
+  return previewResult(settings, image, generatedColors, completed);
+}
 
 // winMgr is used to store the currently loaded image (application wide)
 // and is where we send our new image when the user clicks "Process",
 // among other things.
 colorChooser::colorChooser(windowManager* winMgr)
-  : imageZoomWindow("", winMgr), processMode_(), clickedDock_(NULL) {
+  : imageZoomWindow("", winMgr), processMode_(), clickedDock_(NULL),
+    previewTimer_(new QTimer(this)),
+    previewWatcher_(new QFutureWatcher<previewResult>(this)) {
+
+  previewTimer_->setSingleShot(true);
+  previewTimer_->setInterval(PREVIEW_DELAY);
+  connect(previewTimer_, SIGNAL(timeout()),
+          this, SLOT(updatePreview()));
+  connect(previewWatcher_, SIGNAL(finished()),
+          this, SLOT(previewFinished()));
 
   imageLabel_ = new imageLabel(this);
   connect(imageLabel_, SIGNAL(announceImageClick(QMouseEvent* )),
@@ -79,9 +124,42 @@ void colorChooser::constructMenuObjects() {
   connect(clearListAction_, SIGNAL(triggered()),
           this, SLOT(clearList()));
 
+  previewAction_ = new QAction(tr("Preview colors"), this);
+  previewAction_->setCheckable(true);
+  previewAction_->
+    setToolTip(tr("Show the result of the current color choices on the "
+                  "image as they change"));
+  connect(previewAction_, SIGNAL(toggled(bool )),
+          this, SLOT(processPreviewToggle(bool )));
+
+  metricActions_ = new QActionGroup(this);
+  QAction* rgbAction = new QAction(tr("RGB distance"), metricActions_);
+  rgbAction->setData(metricRgb);
+  rgbAction->setToolTip(tr("Match colors by their red, green and blue "
+                           "differences (the fastest)"));
+  QAction* cie76Action = new QAction(tr("Lab distance (CIE76)"),
+                                     metricActions_);
+  cie76Action->setData(metricCie76);
+  cie76Action->setToolTip(tr("Match colors by how different they look"));
+  QAction* ciede2000Action = new QAction(tr("Lab distance (CIEDE2000)"),
+                                         metricActions_);
+  ciede2000Action->setData(metricCiede2000);
+  ciede2000Action->setToolTip(tr("Match colors by how different they look, "
+                                 "more accurately (and more slowly) than "
+                                 "CIE76"));
+  const QList<QAction*> metricActions = metricActions_->actions();
+  for (int i = 0, size = metricActions.size(); i < size; ++i) {
+    metricActions[i]->setCheckable(true);
+  }
+  connect(metricActions_, SIGNAL(triggered(QAction* )),
+          this, SLOT(processMetricChange(QAction* )));
+
   addZoomActionsToImageMenu();
   imageMenu()->addAction(imageInfoAction());
   imageMenu()->addAction(clearListAction_);
+  imageMenu()->addAction(previewAction_);
+  QMenu* metricMenu = imageMenu()->addMenu(tr("Color matching"));
+  metricMenu->addActions(metricActions);
 }
 
 void colorChooser::constructProcessingObjects() {
@@ -126,6 +204,8 @@ void colorChooser::constructProcessingObjects() {
 
   connect(processButton_, SIGNAL(clicked()),
           this, SLOT(processProcessing()));
+  connect(numColorsBox_, SIGNAL(valueChanged(int )),
+          this, SLOT(schedulePreview()));
 }
 
 void colorChooser::popDock() {
@@ -172,6 +252,19 @@ void colorChooser::restoreSettings() {
     const int numColors = settings.value("color_chooser_num_colors").toInt();
     numColorsBox_->setValue(numColors);
   }
+
+  //// Restore the color matching metric.
+  const colorMetric metric = colorDistance::
+    stringToMetric(settings.value("color_chooser_metric").toString());
+  colorDistance::setMetric(metric);
+  const QList<QAction*> metricActions = metricActions_->actions();
+  for (int i = 0, size = metricActions.size(); i < size; ++i) {
+    metricActions[i]->setChecked(metricActions[i]->data().toInt() == metric);
+  }
+
+  //// Restore the preview setting.
+  previewAction_->setChecked(settings.value("color_chooser_preview",
+                                            false).toBool());
 }
 
 void colorChooser::processMouseMove(QMouseEvent* event) {
@@ -191,7 +284,13 @@ void colorChooser::setNewImage(const QImage& newImage) {
   // course, 2) updateGeometry()ed, 3) pending event queue cleared
   // So we don't do setPermStatus here anymore]
   setPermanentStatusEnabled(true);
-  setLabelImage(newImage);
+  stopPreviewWork();
+  previewTimer_->stop();
+  previewProxy_ = QImage();
+  previewResult_ = previewResult();
+  // (newImage is the window manager's original image, so share its
+  // pyramid)
+  setLabelImage(winManager()->originalPyramid());
   zoomToImage();
   processMode_.clearColorLists();
   clickedDock_->setColorList(::rgbToFloss(processMode_.clickedColorList(),
@@ -199,14 +298,15 @@ void colorChooser::setNewImage(const QImage& newImage) {
   generatedDock_->clearList();
   generatedDockHolder_->setEnabled(false);
   setStatus(processMode_.statusHint());
+  schedulePreview();
 }
 
-void colorChooser::setLabelImage(const QImage& image) {
+void colorChooser::setLabelImage(const imagePyramid& image) {
 
   if (imageLabel_->imageIsNull()) { // this is the first load
     setWidgetActive(true);
   }
-  imageLabel_->setImageAndSize(QPixmap::fromImage(image));
+  imageLabel_->setImageAndSize(image);
 }
 
 void colorChooser::setWidgetActive(bool active) {
@@ -300,6 +400,7 @@ void colorChooser::clearList() {
 
   if (processMode_.resetColorList()) {
     clickedDock_->clearList();
+    schedulePreview();
   }
 }
 
@@ -320,6 +421,7 @@ void colorChooser::processProcessChange(int boxIndex) {
   generatedDock_->setColorList(::rgbToFloss(generatedColors, modeFlossType));
   generatedDockHolder_->setEnabled(!generatedColors.isEmpty());
   setStatus(processMode_.statusHint());
+  schedulePreview();
 }
 
 void colorChooser::processColorAdd(QMouseEvent* event) {
@@ -333,6 +435,7 @@ void colorChooser::processColorAdd(QMouseEvent* event) {
   const triC addedColor = processMode_.addColor(color, &added);
   if (added) {
     clickedDock_->addToList(::rgbToFloss(addedColor, processMode_.flossMode()));
+    schedulePreview();
   }
   else {
     // the color already exists
@@ -352,19 +455,33 @@ void colorChooser::processProcessing() {
                                 " right."));
     return;
   }
-  QImage workingImage = winManager()->originalImage().copy();
-  if (workingImage.isNull()) {
-    qWarning() << "Empty image in processProcessing.";
-    return;
+  stopPreviewWork();
+  QImage workingImage;
+  triState returnCode = triNoop;
+  if (previewResult_.completed() &&
+      previewResult_.settings() == currentPreviewSettings()) {
+    // the background preview already did the work
+    workingImage = previewResult_.image();
+    processMode_.setGeneratedColorList(previewResult_.generatedColors());
+    returnCode = triTrue;
+  }
+  else {
+    workingImage = winManager()->originalImage().copy();
+    if (workingImage.isNull()) {
+      qWarning() << "Empty image in processProcessing.";
+      return;
+    }
+    workingImage = workingImage.convertToFormat(QImage::Format_RGB32);
+    returnCode =
+      processMode_.performProcessing(&workingImage, numColorsBox_->value(),
+                                     winManager()->
+                                     getOriginalImageColorCount());
   }
-  workingImage = workingImage.convertToFormat(QImage::Format_RGB32);
-  const triState returnCode =
-    processMode_.performProcessing(&workingImage, numColorsBox_->value(),
-                                   winManager()->getOriginalImageColorCount());
   //qDebug() << "processing time: " << double(t.elapsed())/1000.;
   if (returnCode != triNoop) {
     const colorCompareSaver saver(-1, 0, processMode_.saveText(),
-                                  processMode_.colorList());
+                                  processMode_.colorList(),
+                                  colorDistance::metric());
     winManager()->addColorCompareImage(workingImage,
                                        processMode_.colorList(),
                                        processMode_.flossMode(),
@@ -389,6 +506,129 @@ void colorChooser::processProcessing() {
 void colorChooser::removeColor(const triC& color) {
 
   processMode_.removeColor(color);
+  schedulePreview();
+}
+
+previewSettings colorChooser::currentPreviewSettings() const {
+
+  // (the number of colors only matters if the box is active)
+  const int numColors =
+    processMode_.numColorsBoxActive() ? numColorsBox_->value() : 0;
+  return previewSettings(processMode_.mode(), numColors,
+                         processMode_.clickedColorList(),
+                         colorDistance::metric());
+}
+
+void colorChooser::schedulePreview() {
+
+  if (previewAction_->isChecked() && !imageLabel_->imageIsNull()) {
+    previewTimer_->start();
+  }
+}
+
+void colorChooser::updatePreview() {
+
+  stopPreviewWork();
+  if (!previewAction_->isChecked() || !isVisible() ||
+      imageLabel_->imageIsNull()) {
+    return;
+  }
+  if (numColorsBox_->value() == 0 && !processMode_.userColorsExist()) {
+    showOriginalImage();
+    return;
+  }
+  const previewSettings settings = currentPreviewSettings();
+  if (previewResult_.completed() && previewResult_.settings() == settings) {
+    imageLabel_->updateImage(previewResult_.image());
+    return;
+  }
+  if (previewProxy_.isNull()) {
+    previewProxy_ = createPreviewProxy(winManager()->originalImage());
+  }
+
+  // the quick version
+  QImage proxyImage = previewProxy_;
+  QVector<triC> generatedColors;
+  const processModePtr mode = processMode_.currentMode();
+  if (!mode->processImage(&proxyImage, settings.clickedColors(),
+                          settings.numColors(), 0, &generatedColors)) {
+    return;
+  }
+  // (the label keeps the original's size, so zooming and color clicks
+  // still map to the original image; the proxy is just stretched over it)
+  imageLabel_->updateImage(proxyImage);
+
+  // the full size version, in the background
+  if (proxyImage.size() != winManager()->originalImage().size()) {
+    colorMatcher::loadDataSources();
+    altMeter::setBackgroundCanceled(false);
+    const QImage fullImage = winManager()->originalImage().
+      convertToFormat(QImage::Format_RGB32);
+    previewWatcher_->setFuture(QtConcurrent::run(processPreview, mode,
+                                                 fullImage, settings));
+  }
+}
+
+void colorChooser::previewFinished() {
+
+  if (previewWatcher_->isCanceled()) {
+    return;
+  }
+  const previewResult result = previewWatcher_->result();
+  if (result.completed() && result.settings() == currentPreviewSettings() &&
+      previewAction_->isChecked()) {
+    previewResult_ = result;
+    imageLabel_->updateImage(result.image());
+  }
+}
+
+void colorChooser::stopPreviewWork() {
+
+  if (previewWatcher_->isRunning()) {
+    altMeter::setBackgroundCanceled(true);
+    previewWatcher_->waitForFinished();
+  }
+  // (don't pick up a result from a canceled run)
+  previewWatcher_->setFuture(QFuture<previewResult>());
+}
+
+void colorChooser::stopPreview() {
+
+  previewTimer_->stop();
+  stopPreviewWork();
+}
+
+void colorChooser::showOriginalImage() {
+
+  if (!imageLabel_->imageIsNull()) {
+    imageLabel_->updateImage(winManager()->originalPyramid());
+  }
+}
+
+void colorChooser::processPreviewToggle(bool checked) {
+
+  QSettings settings("cstitch", "cstitch");
+  settings.setValue("color_chooser_preview", checked);
+  if (checked) {
+    schedulePreview();
+  }
+  else {
+    stopPreview();
+    previewResult_ = previewResult();
+    showOriginalImage();
+  }
+}
+
+void colorChooser::processMetricChange(QAction* action) {
+
+  // background previews read the metric
+  stopPreview();
+  const colorMetric metric = static_cast<colorMetric>(action->data().toInt());
+  colorDistance::setMetric(metric);
+  QSettings settings("cstitch", "cstitch");
+  settings.setValue("color_chooser_metric",
+                    colorDistance::metricToString(metric));
+  schedulePreview();
 }
 
 void colorChooser::displayImageInfo() {
@@ -408,7 +648,9 @@ int colorChooser::recreateImage(const colorCompareSaver& saver) {
   }
   workingImage = workingImage.convertToFormat(QImage::Format_RGB32);
   // we don't need to do processMode_.performProcessing since we already
-  // have the color list it would produce
+  // have the color list it would produce (but we do need to match with the
+  // metric the image was created with)
+  const colorMetricScope metricScope(saver.metric());
   processMode_.restoreSavedImage(&workingImage, saver.colors(),
                                  winManager()->getOriginalImageColorCount());
   winManager()->addColorCompareImage(workingImage,
@@ -20,10 +20,15 @@
 #ifndef COLORCHOOSER_H
 #define COLORCHOOSER_H
 
+#include <QtCore/QFutureWatcher>
+#include <QtGui/QImage>
+
 #include "imageZoomWindow.h"
 #include "colorChooserProcessModes.h"
+#include "colorDistance.h"
 
 class imageLabel;
+class imagePyramid;
 class dockListWidget;
 class dockListSwatchWidget;
 class windowManager;
@@ -35,6 +40,54 @@ class QScrollArea;
 class QPushButton;
 class QComboBox;
 class QSpinBox;
+class QTimer;
+class QActionGroup;
+
+// the inputs to a preview processing run
+class previewSettings {
+ public:
+  previewSettings() : mode_(colorChooserProcessMode::NUM_COLORS),
+    numColors_(0), metric_(metricRgb) {}
+  previewSettings(processModeValue mode, int numColors,
+                  const QVector<triC>& clickedColors, colorMetric metric)
+    : mode_(mode), numColors_(numColors), clickedColors_(clickedColors),
+    metric_(metric) {}
+  processModeValue mode() const { return mode_; }
+  int numColors() const { return numColors_; }
+  const QVector<triC>& clickedColors() const { return clickedColors_; }
+  colorMetric metric() const { return metric_; }
+  bool operator==(const previewSettings& other) const {
+    return mode_ == other.mode_ && numColors_ == other.numColors_ &&
+      clickedColors_ == other.clickedColors_ && metric_ == other.metric_;
+  }
+
+ private:
+  processModeValue mode_;
+  int numColors_;
+  QVector<triC> clickedColors_;
+  colorMetric metric_;
+};
+
+// the result of a preview processing run
+class previewResult {
+ public:
+  previewResult() : completed_(false) {}
+  previewResult(const previewSettings& settings, const QImage& image,
+                const QVector<triC>& generatedColors, bool completed)
+    : settings_(settings), image_(image), generatedColors_(generatedColors),
+    completed_(completed) {}
+  const previewSettings& settings() const { return settings_; }
+  const QImage& image() const { return image_; }
+  const QVector<triC>& generatedColors() const { return generatedColors_; }
+  // false if processing was canceled
+  bool completed() const { return completed_; }
+
+ private:
+  previewSettings settings_;
+  QImage image_;
+  QVector<triC> generatedColors_;
+  bool completed_;
+};
 
 // class colorChooser
 //
@@ -69,6 +122,15 @@ class QSpinBox;
 //
 // Once the user is satisfied with their color mode and selection they
 // click a button to move to the next stage, the colorCompareWindow.
+//
+// If preview is turned on then changes to the mode or color selection
+// are shown on the image right away by processing a small nearest
+// neighbor scaled copy of the original (the "proxy"); the full size image
+// is then processed in the background and replaces the proxy result when
+// it's done (and is used directly if the user clicks "Choose colors"
+// before the settings change).  The proxy has far fewer pixels than the
+// original, so the colors it chooses may differ somewhat from the full
+// size result.
 
 class colorChooser : public imageZoomWindow {
 
@@ -84,6 +146,9 @@ class colorChooser : public imageZoomWindow {
   void appendCurrentSettings(QDomDocument* doc,
                              QDomElement* appendee) const; //override
   QString updateCurrentSettings(const QDomElement& xml); //override
+  // stop any preview processing (which must be stopped before the color
+  // matching data sources are reset)
+  void stopPreview();
 
  private:
   // constructor helper
@@ -101,11 +166,17 @@ class colorChooser : public imageZoomWindow {
   // reset the image to its original size
   void originalSize();
   // set the widget's image
-  void setLabelImage(const QImage& image);
+  void setLabelImage(const imagePyramid& image);
   void setModeBox(const QString& mode);
   // return the helpMode enum value for this mode
   helpMode getHelpMode() const;
   bool horizontalWheelScrollEvent(QObject* watched, QWheelEvent* event) const;
+  // the current preview settings
+  previewSettings currentPreviewSettings() const;
+  // cancel and wait for any background preview processing
+  void stopPreviewWork();
+  // show the original image in place of any preview
+  void showOriginalImage();
 
  private slots:
   // process a "Process" button: create a new image based on the current
@@ -132,6 +203,17 @@ class colorChooser : public imageZoomWindow {
   void zoomToWidth();
   void zoomToHeight();
   void zoomToImage();
+  // restart the preview timer if preview is on
+  void schedulePreview();
+  // process the proxy and show the result, then start full size
+  // processing in the background
+  void updatePreview();
+  // show the result of background preview processing if it's current
+  void previewFinished();
+  // turn preview on or off
+  void processPreviewToggle(bool checked);
+  // match colors with the metric of the chosen <action>
+  void processMetricChange(QAction* action);
 
  private:
   processModeGroup processMode_;
@@ -154,6 +236,19 @@ class colorChooser : public imageZoomWindow {
   QComboBox* processModeBox_;
   // some modes let the user choose how many colors they want to use
   QSpinBox* numColorsBox_;
+
+  // the color matching metric choices, with their colorMetric as data
+  QActionGroup* metricActions_;
+  // turns preview on and off
+  QAction* previewAction_;
+  // delays previews until the user pauses
+  QTimer* previewTimer_;
+  // the original image scaled down for previews (null until needed)
+  QImage previewProxy_;
+  // background processing of the full size image
+  QFutureWatcher<previewResult>* previewWatcher_;
+  // the last completed full size preview, if any
+  previewResult previewResult_;
 };
 
 #endif
@@ -19,10 +19,13 @@
 
 #include "colorChooserProcessModes.h"
 
+#include <QtCore/QMutexLocker>
+
 #include <QtXml/QDomElement>
 
 #include "colorLists.h"
 #include "imageProcessing.h"
+#include "kMeans.h"
 #include "utility.h"
 #include "xmlUtility.h"
 
@@ -33,6 +36,9 @@ processModeGroup::processModeGroup() {
   activeModes_.push_back(processModePtr(new numberOfColorsToDmcMode()));
   activeModes_.push_back(processModePtr(new numberOfColorsToAnchorMode()));
   activeModes_.push_back(processModePtr(new numberOfColorsMode()));
+  activeModes_.push_back(processModePtr(new kMeansToDmcMode()));
+  activeModes_.push_back(processModePtr(new kMeansToAnchorMode()));
+  activeModes_.push_back(processModePtr(new kMeansMode()));
   activeModes_.push_back(processModePtr(new dmcMode()));
   activeModes_.push_back(processModePtr(new anchorMode()));
 }
@@ -176,6 +182,18 @@ flossType numberOfColorsToAnchorMode::flossMode() const {
   return flossAnchor;
 }
 
+flossType kMeansMode::flossMode() const {
+  return flossVariable;
+}
+
+flossType kMeansToDmcMode::flossMode() const {
+  return flossDMC;
+}
+
+flossType kMeansToAnchorMode::flossMode() const {
+  return flossAnchor;
+}
+
 flossType dmcMode::flossMode() const {
   return flossDMC;
 }
@@ -194,6 +212,16 @@ triC numberOfColorsToAnchorMode::addColor(const triC& color, bool* added) {
   return colorChooserProcessMode::addColor(::rgbToAnchor(color), added);
 }
 
+triC kMeansToDmcMode::addColor(const triC& color, bool* added) {
+
+  return colorChooserProcessMode::addColor(::rgbToDmc(color), added);
+}
+
+triC kMeansToAnchorMode::addColor(const triC& color, bool* added) {
+
+  return colorChooserProcessMode::addColor(::rgbToAnchor(color), added);
+}
+
 bool colorChooserProcessMode::removeColor(const triC& color) {
 
   int indexOfColor = clickedColors_.indexOf(color);
@@ -206,13 +234,14 @@ bool colorChooserProcessMode::removeColor(const triC& color) {
 fixedListBaseMode::fixedListBaseMode(const QVector<triC>& colors)
   : colorChooserProcessMode(colors) {}
 
-triState fixedListBaseMode::performProcessing(QImage* image, int ,
-                                              int numImageColors) {
+triState colorChooserProcessMode::performProcessing(QImage* image,
+                                                   int numColors,
+                                                   int numImageColors) {
 
-  QVector<triC> segmentColors = ::segment(image, clickedColorList(),
-                                          numImageColors);
-  if (!segmentColors.empty()) {
-    setGeneratedColorList(segmentColors);
+  QVector<triC> generatedColors;
+  if (processImage(image, clickedColors_, numColors, numImageColors,
+                   &generatedColors)) {
+    setGeneratedColorList(generatedColors);
     return triTrue;
   }
   else {
@@ -220,34 +249,80 @@ triState fixedListBaseMode::performProcessing(QImage* image, int ,
   }
 }
 
-triState numColorsBaseModes::performProcessing(QImage* image, int numColors,
-                                               int numImageColors) {
+bool fixedListBaseMode::processImage(QImage* image,
+                                     const QVector<triC>& clickedColors,
+                                     int , int numImageColors,
+                                     QVector<triC>* generatedColors) const {
+
+  *generatedColors = ::segment(image, clickedColors, numImageColors);
+  return !generatedColors->empty();
+}
+
+bool numColorsBaseModes::processImage(QImage* image,
+                                      const QVector<triC>& clickedColors,
+                                      int numColors, int numImageColors,
+                                      QVector<triC>* generatedColors) const {
 
   colorTransformerPtr transformer =
     colorTransformer::createColorTransformer(flossMode());
   QVector<triC> newColors = ::chooseColors(*image, numColors,
-                                           clickedColorList(),
+                                           clickedColors,
                                            numImageColors,
                                            transformer);
-  if (!newColors.empty()) {
-    // remove the seed colors from newColors to create generatedColors
-    const QVector<triC>& seedColors = clickedColorList();
-    QVector<triC> generatedColors = newColors;
-    for (int i = 0, size = seedColors.size(); i < size; ++i) {
-      generatedColors.remove(generatedColors.indexOf(seedColors[i]));
-    }
-    setGeneratedColorList(generatedColors);
+  if (newColors.empty()) {
+    return false;
   }
-  else {
-    return triNoop;
+  // remove the seed colors from newColors to create generatedColors
+  *generatedColors = newColors;
+  for (int i = 0, size = clickedColors.size(); i < size; ++i) {
+    generatedColors->remove(generatedColors->indexOf(clickedColors[i]));
   }
-  if (!::segment(image, newColors, numImageColors).empty()) {
-    //return triState(colorList().size() != savedColorsSize);
-    return triTrue;
+  return !::segment(image, newColors, numImageColors).empty();
+}
+
+bool kMeansBaseMode::resetColorList() {
+
+  {
+    const QMutexLocker locker(&centroidsMutex_);
+    centroids_.clear();
+    ++centroidsGeneration_;
   }
-  else {
-    return triNoop;
+  return numColorsBaseModes::resetColorList();
+}
+
+bool kMeansBaseMode::processImage(QImage* image,
+                                  const QVector<triC>& clickedColors,
+                                  int numColors, int numImageColors,
+                                  QVector<triC>* generatedColors) const {
+
+  QVector<triC> startCentroids;
+  int generation = 0;
+  {
+    const QMutexLocker locker(&centroidsMutex_);
+    startCentroids = centroids_;
+    generation = centroidsGeneration_;
+  }
+  colorTransformerPtr transformer =
+    colorTransformer::createColorTransformer(flossMode());
+  QVector<triC> centroids;
+  QVector<triC> newColors = ::kMeansColors(*image, numColors, clickedColors,
+                                           startCentroids, transformer,
+                                           &centroids);
+  if (newColors.empty()) {
+    return false;
+  }
+  {
+    const QMutexLocker locker(&centroidsMutex_);
+    if (generation == centroidsGeneration_) {
+      centroids_ = centroids;
+    }
+  }
+  // remove the seed colors from newColors to create generatedColors
+  *generatedColors = newColors;
+  for (int i = 0, size = clickedColors.size(); i < size; ++i) {
+    generatedColors->remove(generatedColors->indexOf(clickedColors[i]));
   }
+  return !::segment(image, newColors, numImageColors).empty();
 }
 
 QString processModeGroup::savedModeTextToLocale(const QString& mode) const {
@@ -20,6 +20,7 @@
 #ifndef COLORCHOOSERPROCESSMODES_H
 #define COLORCHOOSERPROCESSMODES_H
 
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QSharedData>
 #include <QtCore/QVector>
@@ -74,7 +75,8 @@ class colorChooserProcessMode : public QSharedData {
 
  public:
   enum processMode { NUM_COLORS, NUM_COLORS_TO_DMC, NUM_COLORS_TO_ANCHOR,
-                     DMC, ANCHOR };
+                     DMC, ANCHOR, K_MEANS, K_MEANS_TO_DMC,
+                     K_MEANS_TO_ANCHOR };
 
  public:
   // input the color list for this mode
@@ -114,8 +116,17 @@ class colorChooserProcessMode : public QSharedData {
   // return triNoop if the user cancels processing, triTrue if the color
   // list was updated by completed processing, and triFalse if processing
   // completed but the color list doesn't need updating
-  virtual triState performProcessing(QImage* image, int numColors,
-                                     int numImageColors) = 0;
+  triState performProcessing(QImage* image, int numColors,
+                             int numImageColors);
+  // perform this mode's processing on <image> with <clickedColors> in
+  // place of the mode's clicked color list, and set <generatedColors> to
+  // the colors generated; doesn't change the mode, so may be called from
+  // a background thread
+  // return false if processing was canceled
+  virtual bool processImage(QImage* image,
+                            const QVector<triC>& clickedColors,
+                            int numColors, int numImageColors,
+                            QVector<triC>* generatedColors) const = 0;
   virtual processMode mode() const = 0;
   // if we're only using one floss type, return that type, otherwise
   // return flossVariable
@@ -180,6 +191,8 @@ class processModeGroup {
   }
   triState performProcessing(QImage* image, int numColors,
                              int numImageColors);
+  // the current mode, for processImage calls
+  processModePtr currentMode() const { return curMode_; }
   QString statusHint() const { return curMode_->statusHint(); }
   QVector<triC> colorList() const { return curMode_->colorList(); }
   const QVector<triC>& clickedColorList() const {
@@ -205,6 +218,9 @@ class processModeGroup {
   const QVector<triC>& generatedColorList() const {
     return curMode_->generatedColorList();
   }
+  void setGeneratedColorList(const QVector<triC>& colorList) {
+    curMode_->setGeneratedColorList(colorList);
+  }
   QString toolTip(const QString& modeText) const;
   bool userColorsExist() const {
     return !curMode_->clickedColorList().isEmpty();
@@ -227,8 +243,9 @@ class numColorsBaseModes : public colorChooserProcessMode {
     return processChange(true, true, true, QObject::tr("Clicked colors"),
                          clickedColorList(), generatedColorList());
   }
-  triState performProcessing(QImage* image, int numColors,
-                             int numImageColors);
+  bool processImage(QImage* image, const QVector<triC>& clickedColors,
+                    int numColors, int numImageColors,
+                    QVector<triC>* generatedColors) const;
   QString statusHint() const {
     return QObject::tr("Select the number of colors to be chosen from the "
                        "number box and/or click on a color on the image to add "
@@ -277,6 +294,75 @@ class numberOfColorsToAnchorMode : public numColorsBaseModes {
   }
 };
 
+// base for k_means, k_means_to_dmc, and k_means_to_anchor modes, which
+// choose their colors by clustering (see kMeansColors) instead of with
+// chooseColors
+class kMeansBaseMode : public numColorsBaseModes {
+ public:
+  kMeansBaseMode() : centroidsGeneration_(0) {}
+  // also forgets the cluster centers, so that clustering for a new image
+  // or a cleared list doesn't start from the old ones
+  bool resetColorList();
+  bool processImage(QImage* image, const QVector<triC>& clickedColors,
+                    int numColors, int numImageColors,
+                    QVector<triC>* generatedColors) const;
+  QString statusHint() const {
+    return QObject::tr("Select the number of colors to be found by "
+                       "clustering the image's colors and/or click on a "
+                       "color on the image to add it");
+  }
+
+ private:
+  // the cluster centers from the last run, which the next run starts
+  // from (processImage can run in the background, hence the mutex)
+  mutable QMutex centroidsMutex_;
+  mutable QVector<triC> centroids_;
+  // incremented by resetColorList, so that a run that started before a
+  // reset doesn't store its centers
+  int centroidsGeneration_;
+};
+
+class kMeansMode : public kMeansBaseMode {
+ public:
+  processMode mode() const { return K_MEANS; }
+  flossType flossMode() const;
+  QString modeText() const { return QObject::tr("K-means"); }
+  QString saveText() const { return "K-means"; }
+  QString toolTip() const {
+    return QObject::tr("Click on colors and/or let the program find a "
+                       "specified number of colors by clustering the "
+                       "image's colors");
+  }
+};
+
+class kMeansToDmcMode : public kMeansBaseMode {
+ public:
+  triC addColor(const triC& color, bool* added);
+  processMode mode() const { return K_MEANS_TO_DMC; }
+  flossType flossMode() const;
+  QString modeText() const { return QObject::tr("K-means to DMC"); }
+  QString saveText() const { return "K-means to DMC"; }
+  QString toolTip() const {
+    return QObject::tr("Click on colors and/or let the program find a "
+                       "specified number of DMC colors by clustering the "
+                       "image's colors");
+  }
+};
+
+class kMeansToAnchorMode : public kMeansBaseMode {
+ public:
+  triC addColor(const triC& color, bool* added);
+  processMode mode() const { return K_MEANS_TO_ANCHOR; }
+  flossType flossMode() const;
+  QString modeText() const { return QObject::tr("K-means to Anchor"); }
+  QString saveText() const { return "K-means to Anchor"; }
+  QString toolTip() const {
+    return QObject::tr("Click on colors and/or let the program find a "
+                       "specified number of Anchor colors by clustering the "
+                       "image's colors");
+  }
+};
+
 class fixedListBaseMode : public colorChooserProcessMode {
  public:
   fixedListBaseMode(const QVector<triC>& colors);
@@ -284,8 +370,9 @@ class fixedListBaseMode : public colorChooserProcessMode {
   virtual bool resetColorList() { return false; }
   bool removeColor(const triC& ) { return true; }
   void appendColorList(QDomDocument* , QDomElement* ) { return; }
-  triState performProcessing(QImage* image, int numColors,
-                             int numImageColors);
+  bool processImage(QImage* image, const QVector<triC>& clickedColors,
+                    int numColors, int numImageColors,
+                    QVector<triC>* generatedColors) const;
 };
 
 class dmcMode : public fixedListBaseMode {
@@ -38,6 +38,7 @@
 #include "helpBrowser.h"
 #include "dimensionComputer.h"
 #include "xmlUtility.h"
+#include "trace.h"
 
 // min/max user-selectable square sizes
 extern const int SQUARE_SIZE_MIN = 1;
@@ -169,7 +170,8 @@ void colorCompare::addImage(const QImage& image, int index,
       new mutableImageContainer(imageName, image, colors, type);
   }
   else {
-    rightImage_ = new immutableImageContainer(imageName, image);
+    rightImage_ = new immutableImageContainer(imageName,
+                                              winManager()->originalPyramid());
   }
   QAction* leftAction = new QAction(imageName, this);
   leftAction->setData(QVariant::fromValue(rightImage_));
@@ -221,6 +223,7 @@ void colorCompare::processSquareButton(imagePtr container,
                                        QString squareModeString,
                                        int squareSize, int newIndex) {
 
+  const traceSpan span("colorCompare::processSquareButton");
   int squareMode = squareMode_;
   if (!container) { // user pushed the process button
     container = curImage_;
@@ -250,24 +253,24 @@ void colorCompare::processSquareButton(imagePtr container,
     case SQ_MEDIAN:
     {
       squareModeString = "median";
+      traceSpan step("processSquareButton: to grid");
       grid newGrid(container->image());
       if (newGrid.empty()) {
         qWarning() << "Empty grid in process square:" <<
           container->originalWidth() << container->originalHeight();
         return;
       }
-      //qDebug() << "to grid time:" << double(t.elapsed())/1000.;
+      step.restart("processSquareButton: median");
       colorsUsed = ::median(&newGrid, grid(originalImage()),
                             squareSize);
-      //qDebug() << "median time:" << double(t.elapsed())/1000.;
       if (!colorsUsed.empty()) {
+        step.restart("processSquareButton: to QImage");
         newImage = newGrid.toImage();
         if (newImage.isNull()) {
           qWarning() << "Empty image in process square" <<
             newGrid.width() << newGrid.height();
           return;
         }
-        //qDebug() << "to QImage time: " << double(t.elapsed())/1000.;
       }
       else { // processing was cancelled
         return;
@@ -278,8 +281,8 @@ void colorCompare::processSquareButton(imagePtr container,
     {
       squareModeString = "mode";
       newImage = container->image();
+      const traceSpan step("processSquareButton: mode");
       colorsUsed = ::mode(&newImage, squareSize);
-      //qDebug() << "mode time: " << double(t.elapsed())/1000.;
       break;
     }
     default:
@@ -345,7 +348,8 @@ void colorCompare::displayImageInfo() {
                                .arg(curImage_->name())
                                .arg(::itoqs(width))
                                .arg(::itoqs(height))
-                               .arg(flossString));
+                               .arg(flossString) +
+                             imageInfoMemoryString(curImage_->memory()));
   }
 }
 
@@ -399,7 +403,7 @@ helpMode colorCompare::getHelpMode() const {
 }
 
 void colorCompare::updateImageLabelImage() {
-  activeImageLabel()->updateImage(QPixmap::fromImage(curImage_->image()));
+  activeImageLabel()->updateImage(curImage_->pyramid());
 }
 
 // these are here just so we don't have to include imageLabel.h in
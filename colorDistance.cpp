@@ -0,0 +1,345 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "colorDistance.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include <QtCore/QPair>
+#include <QtCore/qmath.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "triC.h"
+
+// the D65 reference white
+const double WHITE_X = 0.95047;
+const double WHITE_Z = 1.08883;
+// the Lab coordinate used to pad labColorLists (far enough from every
+// real color that it's never closest, but not so far that squaring it
+// overflows)
+const float PADDING_COORDINATE = 1.0e6f;
+// a bound on the CIEDE2000 lightness weight (its value at lightness 0 or
+// 100)
+const double MAX_LIGHTNESS_WEIGHT = 1.7471;
+// the CIEDE2000 search only skips a color if its lower bound exceeds the
+// best distance so far by more than this (to allow for rounding)
+const double CIEDE2000_BOUND_SLACK = 1.0e-6;
+
+QAtomicInt colorDistance::metric_(metricRgb);
+
+QString colorDistance::metricToString(colorMetric metric) {
+
+  switch (metric) {
+  case metricCie76:
+    return "cie76";
+  case metricCiede2000:
+    return "ciede2000";
+  case metricRgb:
+  default:
+    return "rgb";
+  }
+}
+
+colorMetric colorDistance::stringToMetric(const QString& text) {
+
+  if (text == "cie76") {
+    return metricCie76;
+  }
+  else if (text == "ciede2000") {
+    return metricCiede2000;
+  }
+  return metricRgb;
+}
+
+// return the linear value of each 8 bit sRGB channel value
+static QVector<double> linearChannelValues() {
+
+  QVector<double> values(256);
+  for (int i = 0; i < 256; ++i) {
+    const double value = i/255.0;
+    values[i] = (value <= 0.04045) ? value/12.92 :
+      std::pow((value + 0.055)/1.055, 2.4);
+  }
+  return values;
+}
+
+// the Lab f(t) function
+static inline double labF(double t) {
+
+  return (t > 216.0/24389.0) ? std::pow(t, 1.0/3.0) :
+    (24389.0/27.0*t + 16.0)/116.0;
+}
+
+labColor::labColor(const triC& color) {
+
+  // (initialization of a function static is thread safe)
+  static const QVector<double> linear = linearChannelValues();
+  const double r = linear[color.r()];
+  const double g = linear[color.g()];
+  const double b = linear[color.b()];
+  const double fx = labF((0.4124564*r + 0.3575761*g + 0.1804375*b)/WHITE_X);
+  const double fy = labF(0.2126729*r + 0.7151522*g + 0.0721750*b);
+  const double fz = labF((0.0193339*r + 0.1191920*g + 0.9503041*b)/WHITE_Z);
+  l_ = static_cast<float>(116.0*fy - 16.0);
+  a_ = static_cast<float>(500.0*(fx - fy));
+  b_ = static_cast<float>(200.0*(fy - fz));
+}
+
+// return the hue angle in degrees (in [0, 360)) of (<a>, <b>)
+static inline double hueAngle(double a, double b) {
+
+  if (a == 0 && b == 0) {
+    return 0;
+  }
+  const double angle = std::atan2(b, a)*180.0/M_PI;
+  return (angle < 0) ? angle + 360.0 : angle;
+}
+
+// the CIEDE2000 lightness weight S_L for mean lightness <meanL>
+static inline double lightnessWeight(double meanL) {
+
+  const double lOffset = (meanL - 50.0)*(meanL - 50.0);
+  return 1.0 + 0.015*lOffset/std::sqrt(20.0 + lOffset);
+}
+
+// the CIEDE2000 difference between (<l1>, <a1>, <b1>) with chroma <c1>
+// and (<l2>, <a2>, <b2>) with chroma <c2>
+// (see Sharma, Wu and Dalal, "The CIEDE2000 Color-Difference Formula")
+static double ciede2000(double l1, double a1, double b1, double c1,
+                        double l2, double a2, double b2, double c2) {
+
+  const double degrees = M_PI/180.0;
+  const double meanC = (c1 + c2)/2.0;
+  const double meanC7 = std::pow(meanC, 7.0);
+  const double g = 0.5*(1.0 - std::sqrt(meanC7/(meanC7 + 6103515625.0)));
+  const double a1Prime = (1.0 + g)*a1;
+  const double a2Prime = (1.0 + g)*a2;
+  const double c1Prime = std::sqrt(a1Prime*a1Prime + b1*b1);
+  const double c2Prime = std::sqrt(a2Prime*a2Prime + b2*b2);
+  const double h1Prime = hueAngle(a1Prime, b1);
+  const double h2Prime = hueAngle(a2Prime, b2);
+
+  const double deltaL = l2 - l1;
+  const double deltaC = c2Prime - c1Prime;
+  double deltah = 0;
+  if (c1Prime*c2Prime != 0) {
+    deltah = h2Prime - h1Prime;
+    if (deltah > 180.0) {
+      deltah -= 360.0;
+    }
+    else if (deltah < -180.0) {
+      deltah += 360.0;
+    }
+  }
+  const double deltaH =
+    2.0*std::sqrt(c1Prime*c2Prime)*std::sin(deltah*degrees/2.0);
+
+  const double meanL = (l1 + l2)/2.0;
+  const double meanCPrime = (c1Prime + c2Prime)/2.0;
+  double meanH = h1Prime + h2Prime;
+  if (c1Prime*c2Prime != 0) {
+    if (std::fabs(h1Prime - h2Prime) <= 180.0) {
+      meanH /= 2.0;
+    }
+    else if (meanH < 360.0) {
+      meanH = (meanH + 360.0)/2.0;
+    }
+    else {
+      meanH = (meanH - 360.0)/2.0;
+    }
+  }
+  const double t = 1.0 - 0.17*std::cos((meanH - 30.0)*degrees) +
+    0.24*std::cos(2.0*meanH*degrees) +
+    0.32*std::cos((3.0*meanH + 6.0)*degrees) -
+    0.20*std::cos((4.0*meanH - 63.0)*degrees);
+  const double hueOffset = (meanH - 275.0)/25.0;
+  const double deltaTheta = 30.0*std::exp(-hueOffset*hueOffset);
+  const double meanCPrime7 = std::pow(meanCPrime, 7.0);
+  const double rc = 2.0*std::sqrt(meanCPrime7/(meanCPrime7 + 6103515625.0));
+  const double sl = lightnessWeight(meanL);
+  const double sc = 1.0 + 0.045*meanCPrime;
+  const double sh = 1.0 + 0.015*meanCPrime*t;
+  const double rt = -std::sin(2.0*deltaTheta*degrees)*rc;
+
+  const double lTerm = deltaL/sl;
+  const double cTerm = deltaC/sc;
+  const double hTerm = deltaH/sh;
+  return std::sqrt(lTerm*lTerm + cTerm*cTerm + hTerm*hTerm +
+                   rt*cTerm*hTerm);
+}
+
+float ciede2000(const labColor& c1, const labColor& c2) {
+
+  const double chroma1 = std::sqrt(c1.a()*c1.a() + c1.b()*c1.b());
+  const double chroma2 = std::sqrt(c2.a()*c2.a() + c2.b()*c2.b());
+  return static_cast<float>(::ciede2000(c1.l(), c1.a(), c1.b(), chroma1,
+                                        c2.l(), c2.a(), c2.b(), chroma2));
+}
+
+labColorList::labColorList(const QVector<triC>& colors)
+  : size_(colors.size()) {
+
+  const int paddedSize = (size_ + 3)/4*4;
+  l_ = QVector<float>(paddedSize, PADDING_COORDINATE);
+  a_ = QVector<float>(paddedSize, PADDING_COORDINATE);
+  b_ = QVector<float>(paddedSize, PADDING_COORDINATE);
+  chroma_ = QVector<float>(paddedSize, 0);
+  for (int i = 0; i < size_; ++i) {
+    const labColor color(colors[i]);
+    l_[i] = color.l();
+    a_[i] = color.a();
+    b_[i] = color.b();
+    chroma_[i] = std::sqrt(color.a()*color.a() + color.b()*color.b());
+  }
+  QVector<QPair<float, int> > lightnessOrder;
+  lightnessOrder.reserve(size_);
+  for (int i = 0; i < size_; ++i) {
+    lightnessOrder.push_back(qMakePair(l_[i], i));
+  }
+  std::sort(lightnessOrder.begin(), lightnessOrder.end());
+  sortedL_.reserve(size_);
+  lightnessOrder_.reserve(size_);
+  for (int i = 0; i < size_; ++i) {
+    sortedL_.push_back(lightnessOrder[i].first);
+    lightnessOrder_.push_back(lightnessOrder[i].second);
+  }
+}
+
+int labColorList::closestIndex(const labColor& color,
+                               colorMetric metric) const {
+
+  if (size_ == 0) {
+    return -1;
+  }
+  if (metric == metricCiede2000) {
+    return closestCiede2000Index(color);
+  }
+  return closestCie76Index(color);
+}
+
+int closestPointIndex(const float* xs, const float* ys, const float* zs,
+                      int paddedSize, float x, float y, float z) {
+
+#ifdef __SSE2__
+  const __m128 pointX = _mm_set1_ps(x);
+  const __m128 pointY = _mm_set1_ps(y);
+  const __m128 pointZ = _mm_set1_ps(z);
+  __m128 minDistances = _mm_set1_ps(FLT_MAX);
+  __m128i minIndices = _mm_setzero_si128();
+  __m128i indices = _mm_setr_epi32(0, 1, 2, 3);
+  const __m128i four = _mm_set1_epi32(4);
+  for (int i = 0; i < paddedSize; i += 4) {
+    const __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), pointX);
+    const __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), pointY);
+    const __m128 dz = _mm_sub_ps(_mm_loadu_ps(zs + i), pointZ);
+    const __m128 distances =
+      _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                 _mm_mul_ps(dz, dz));
+    // strictly less, so each lane keeps its first minimum
+    const __m128i closer =
+      _mm_castps_si128(_mm_cmplt_ps(distances, minDistances));
+    minDistances = _mm_min_ps(distances, minDistances);
+    minIndices = _mm_or_si128(_mm_and_si128(closer, indices),
+                              _mm_andnot_si128(closer, minIndices));
+    indices = _mm_add_epi32(indices, four);
+  }
+  float laneDistances[4];
+  int laneIndices[4];
+  _mm_storeu_ps(laneDistances, minDistances);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(laneIndices), minIndices);
+  int chosenIndex = laneIndices[0];
+  float min = laneDistances[0];
+  for (int lane = 1; lane < 4; ++lane) {
+    if (laneDistances[lane] < min ||
+        (laneDistances[lane] == min && laneIndices[lane] < chosenIndex)) {
+      min = laneDistances[lane];
+      chosenIndex = laneIndices[lane];
+    }
+  }
+  return chosenIndex;
+#else
+  float min = FLT_MAX;
+  int chosenIndex = 0;
+  for (int i = 0; i < paddedSize; ++i) {
+    const float dx = xs[i] - x;
+    const float dy = ys[i] - y;
+    const float dz = zs[i] - z;
+    const float distance = dx*dx + dy*dy + dz*dz;
+    if (distance < min) {
+      min = distance;
+      chosenIndex = i;
+    }
+  }
+  return chosenIndex;
+#endif
+}
+
+int labColorList::closestCie76Index(const labColor& color) const {
+
+  return ::closestPointIndex(l_.constData(), a_.constData(), b_.constData(),
+                             l_.size(), color.l(), color.a(), color.b());
+}
+
+int labColorList::closestCiede2000Index(const labColor& color) const {
+
+  const double l = color.l();
+  const double colorChroma =
+    std::sqrt(color.a()*color.a() + color.b()*color.b());
+  // visit the colors outward from <color>'s lightness, nearest lightness
+  // first
+  int above = std::lower_bound(sortedL_.constBegin(), sortedL_.constEnd(),
+                               color.l()) - sortedL_.constBegin();
+  int below = above - 1;
+  double min = DBL_MAX;
+  int chosenIndex = 0;
+  while (below >= 0 || above < size_) {
+    int position;
+    if (above >= size_ ||
+        (below >= 0 && l - sortedL_[below] < sortedL_[above] - l)) {
+      position = below--;
+    }
+    else {
+      position = above++;
+    }
+    const double deltaL = std::fabs(sortedL_[position] - l);
+    // every color left has at least this lightness difference
+    if (deltaL/MAX_LIGHTNESS_WEIGHT > min + CIEDE2000_BOUND_SLACK) {
+      break;
+    }
+    const int i = lightnessOrder_[position];
+    if (deltaL/lightnessWeight((l + l_[i])/2.0) >
+        min + CIEDE2000_BOUND_SLACK) {
+      continue;
+    }
+    const double distance =
+      ::ciede2000(color.l(), color.a(), color.b(), colorChroma,
+                  l_[i], a_[i], b_[i], chroma_[i]);
+    if (distance < min || (distance == min && i < chosenIndex)) {
+      min = distance;
+      chosenIndex = i;
+    }
+  }
+  return chosenIndex;
+}
@@ -0,0 +1,145 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef COLORDISTANCE_H
+#define COLORDISTANCE_H
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+class triC;
+
+// the distance used to decide which of a list of colors is closest to a
+// given color: the rgb ds(), or the CIE76 or CIEDE2000 color difference
+// in Lab space
+enum colorMetric {metricRgb, metricCie76, metricCiede2000};
+
+// colorDistance holds the metric the processing kernels (segment,
+// chooseColorsFromList, colorMatcher) currently match with.  It may be
+// read from any thread.
+class colorDistance {
+
+ public:
+  static colorMetric metric() {
+    return static_cast<colorMetric>(metric_.load());
+  }
+  static void setMetric(colorMetric metric) { metric_.store(metric); }
+  // the (untranslated) save/settings text for <metric>
+  static QString metricToString(colorMetric metric);
+  // the metric for <text>, or metricRgb if <text> isn't one
+  static colorMetric stringToMetric(const QString& text);
+
+ private:
+  static QAtomicInt metric_;
+};
+
+// colorMetricScope sets the current metric to <metric> for its lifetime
+// (to recreate an image with the metric it was created with, say).  Only
+// use it while no other thread is processing.
+class colorMetricScope {
+
+ public:
+  explicit colorMetricScope(colorMetric metric)
+    : oldMetric_(colorDistance::metric()) {
+    colorDistance::setMetric(metric);
+  }
+  ~colorMetricScope() { colorDistance::setMetric(oldMetric_); }
+
+ private:
+  Q_DISABLE_COPY(colorMetricScope)
+  const colorMetric oldMetric_;
+};
+
+// a CIE Lab color (D65 white point)
+class labColor {
+
+ public:
+  labColor() : l_(0), a_(0), b_(0) {}
+  // converts <color> from sRGB
+  explicit labColor(const triC& color);
+  float l() const { return l_; }
+  float a() const { return a_; }
+  float b() const { return b_; }
+
+ private:
+  float l_;
+  float a_;
+  float b_;
+};
+
+// the CIEDE2000 color difference between <c1> and <c2>
+float ciede2000(const labColor& c1, const labColor& c2);
+
+// return the index of the point closest to (<x>, <y>, <z>) (in euclidean
+// distance) of the <paddedSize> points with coordinates <xs>, <ys> and
+// <zs>, computing four distances at a time with SSE2; <paddedSize> must
+// be a multiple of four (pad with far away points), and ties go to the
+// lower index
+int closestPointIndex(const float* xs, const float* ys, const float* zs,
+                      int paddedSize, float x, float y, float z);
+
+// labColorList holds the Lab values of a list of colors for finding the
+// color on the list closest to a given color.
+//
+//// Implementation notes
+//
+// The Lab coordinates (and the chroma, which CIEDE2000 needs for each
+// color) are stored as separate arrays padded out to a multiple of
+// four with far away colors, so that the CIE76 search can use
+// closestPointIndex.  Ties go to the earlier color on the list, the same
+// as the rgb searches.
+//
+// CIEDE2000 is too expensive to evaluate for every color on the list, so
+// the search visits the colors in order of their lightness difference
+// from the input and skips those that can't be closer than the best so
+// far.  The squared difference is (dL/S_L)^2 + (dC/S_C)^2 + (dH/S_H)^2 +
+// R_T(dC/S_C)(dH/S_H) with |R_T| < 2, so the last three terms sum to at
+// least zero and dL/S_L is a lower bound.  S_L only depends on the mean
+// lightness and is largest at lightness 0 and 100, which bounds all of
+// the remaining colors once one is far enough away in lightness.  The
+// answer is the same as that of a full search.
+//
+class labColorList {
+
+ public:
+  labColorList() : size_(0) {}
+  explicit labColorList(const QVector<triC>& colors);
+  int size() const { return size_; }
+  // return the index of the color on the list closest to <color> under
+  // <metric> (which must be a Lab metric), or -1 if the list is empty
+  int closestIndex(const labColor& color, colorMetric metric) const;
+
+ private:
+  int closestCie76Index(const labColor& color) const;
+  int closestCiede2000Index(const labColor& color) const;
+
+  int size_;
+  // padded to a multiple of four
+  QVector<float> l_;
+  QVector<float> a_;
+  QVector<float> b_;
+  QVector<float> chroma_;
+  // the (unpadded) lightnesses sorted, and the index of each
+  QVector<float> sortedL_;
+  QVector<int> lightnessOrder_;
+};
+
+#endif
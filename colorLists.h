@@ -22,10 +22,12 @@
 
 #include <QtCore/QVector>
 
+#include "colorDistance.h"
 #include "triC.h"
 #include "floss.h"
 
 class colorTransformer;
+class flossPalette;
 template<class T> class QSharedPointer;
 typedef QSharedPointer<colorTransformer> colorTransformerPtr;
 
@@ -108,44 +110,43 @@ public:
   }
 };
 
-// colorMatcher's job is to find the closest match to a given color on either
-// the dmc or anchor color list.
+// colorMatcher's job is to find the closest match to a given color on a
+// floss palette (see flossPalette.h).
 ////
 // Implementation notes: colorMatcher only searches for matches amongst colors
-// on the color list with the same order type as color_ (dmcColorsHash_ and
-// anchorColorsHash_ track those sublists).  Things are further sped up by
-// precomputing *IntensitySpreads_, which, for a given color order, compute the
-// max distance from color_.intensity() you need to look on a dmc or anchor
-// color list for a closest distance-squared match (i.e. if c_match is the
-// closest distance_squared color on the color list to color_, then
+// on the palette with the same order type as color_.  Things are further sped
+// up by the palette's intensity spreads, which, for a given color order,
+// give the max distance from color_.intensity() you need to look on the
+// palette for a closest distance-squared match (i.e. if c_match is the
+// closest distance_squared color on the palette to color_, then
 // |c_match.intensity() - color_.intensity()| < intensity_spread_value). Those
 // values allow us to quickly narrow down our search by binary searching on
 // intensity rather than on the slower and non-linearly ordered distance
-// squared.
+// squared.  With a Lab metric the order and intensity shortcuts don't
+// apply, so the palette does the matching itself (see
+// flossPalette::labClosestMatch).
 class colorMatcher {
  public:
+  // match against the built in palette for <type>
+  // match using the current colorDistance metric
   colorMatcher(flossType type, const triC& color);
+  colorMatcher(const flossPalette& palette, const triC& color);
   triC closestMatch() const;
+  // swap in the palettes for the current project version
   static void resetDataSources();
- private:
-  void loadColorList(const orderComparator* comparator,
-                     const QVector<triC>& colors,
-                     QVector<iColor>* newList) const;
+  // build the palettes now (on the gui thread) rather than on first use;
+  // the palettes are immutable once built, so colorMatchers can be used
+  // from any number of threads
+  static void loadDataSources();
  private:
   const triC color_;
-  // The list of colors on the dmc or anchor list matching the color order of
-  // color_.
+  const flossPalette* palette_;
+  const colorMetric metric_;
+  // The list of colors on the palette matching the color order of color_
+  // (only used with metricRgb).
   QVector<iColor> colorList_;
   // The intensity spread value to be used with color_.
   int intensitySpread_;
-  // Key is a color order, value is all dmc colors having that color order.
-  static QHash<colorOrder, QVector<iColor> > dmcColorsHash_;
-  // Key is a color order, value is an int <d> with the property that an
-  // arbitrary color with the given color order is, with respect to intensity,
-  // within <d> of some dmc color with the same color order.
-  static QHash<colorOrder, int> dmcIntensitySpreads_;
-  static QHash<colorOrder, QVector<iColor> > anchorColorsHash_;
-  static QHash<colorOrder, int> anchorIntensitySpreads_;
 };
 
 inline colorOrder getColorOrder(const triC& color) {
@@ -186,7 +187,12 @@ inline colorOrder getColorOrder(const triC& color) {
   }
 }
 
+// return true if the current project uses the post 0.9.5.29 DMC list
+bool useNewDmcColorList();
 QVector<floss> initializeDMC();
+// the DMC list used by projects after 0.9.5.29, and the one used before
+QVector<floss> initializePost0_9_5_29DMC();
+QVector<floss> initializePre0_9_5_30DMC();
 QVector<floss> initializeAnchor();
 
 // return the DMC colors
@@ -215,5 +221,9 @@ QVector<triC> rgbToColorList(const QVector<triC>& rgbColors,
 
 // Return the floss code for each flossColor in <colors> in the same order.
 QVector<int> rgbToCode(const QVector<flossColor>& colors);
+// Return the <type> floss with color <color>, or floss(<color>) (whose
+// code is -1) if <type> isn't DMC or Anchor or <color> isn't one of its
+// colors.  The lookup is a hash lookup, not a list search.
+floss colorToFloss(const triC& color, flossType type);
 
 #endif
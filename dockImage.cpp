@@ -22,7 +22,7 @@
 #include <QtGui/QPainter>
 #include <QtGui/QMouseEvent>
 
-dockImage::dockImage(const QImage& originalImage, QWidget* parent)
+dockImage::dockImage(const imagePyramid& originalImage, QWidget* parent)
   : constWidthDock(parent), originalImageRef_(originalImage),
     showingOriginal_(true), dragging_(false) {
 
@@ -32,10 +32,10 @@ dockImage::dockImage(const QImage& originalImage, QWidget* parent)
 void dockImage::setImage(const QImage& image) {
 
   const int width = dockWidth() - 5; // leave a border of 5 on the right
-  originalImage_ = QPixmap::fromImage(
-    originalImageRef_.copy(0, 0, image.width(), image.height()).
-    scaledToWidth(width));
   image_ = QPixmap::fromImage(image.scaledToWidth(width));
+  originalImage_ = QPixmap::fromImage(
+    originalImageRef_.scaled(QRect(0, 0, image.width(), image.height()),
+                             image_.size()));
   setFixedSize(width, image_.height());
 }
 
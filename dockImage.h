@@ -26,6 +26,7 @@
 #include <QPixmap>
 
 #include "constWidthDock.h"
+#include "imagePyramid.h"
 
 // the dockImage appears in a dock widget and displays one of two images
 // at a time: an original image or another image (which in practice is a
@@ -43,7 +44,7 @@ class dockImage : public constWidthDock {
   Q_OBJECT
 
  public:
-  dockImage(const QImage& originalImage, QWidget* parent);
+  dockImage(const imagePyramid& originalImage, QWidget* parent);
   // set the non-original <image>, scaled to fit the dock width, and
   // create a new original image cropped from the upper left corner to
   // the size of <image>
@@ -74,8 +75,9 @@ class dockImage : public constWidthDock {
  private:
   QPixmap image_; // the non-original image
   // the portion of the original image that we show may depend on the size
-  // of image_, so keep a ref to the unaltered version
-  const QImage& originalImageRef_;
+  // of image_, so keep the unaltered version (its pyramid levels make the
+  // thumbnail cheap)
+  const imagePyramid originalImageRef_;
   QPixmap originalImage_;
   bool showingOriginal_; // true if the original image is currently shown
   bool dragging_; // true if mouse is being drug in this widget
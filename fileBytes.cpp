@@ -0,0 +1,151 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "fileBytes.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSettings>
+
+// the default memory budget for holding the bytes in memory when they
+// can't be mapped
+const int ORIGINAL_IMAGE_MEGABYTES = 64;
+// the chunk size for copying unmapped bytes from the file
+const qint64 COPY_CHUNK_BYTES = 1 << 20;
+
+void fileBytes::setFile(const QString& fileName, qint64 offset,
+                        qint64 size) {
+
+  clear();
+  const QFileInfo info(fileName);
+  fileName_ = info.canonicalFilePath();
+  offset_ = offset;
+  size_ = size;
+  fileSize_ = info.size();
+  fileModified_ = info.lastModified();
+
+  file_.setFileName(fileName_);
+  if (file_.open(QIODevice::ReadOnly)) {
+    map_ = file_.map(offset_, size_);
+    if (map_) {
+      return;
+    }
+    // no mapping, so hold the bytes if they fit the budget, else leave them
+    // in the file
+    const QSettings settings("cstitch", "cstitch");
+    const qint64 budget =
+      settings.value("original_image_memory",
+                     ORIGINAL_IMAGE_MEGABYTES).toLongLong() * 1024 * 1024;
+    if (size_ <= budget && file_.seek(offset_)) {
+      data_ = file_.read(size_);
+      if (data_.size() != size_) {
+        data_.clear();
+      }
+    }
+    file_.close();
+  }
+  else {
+    qWarning() << "Unable to open original image file" << fileName_;
+  }
+}
+
+void fileBytes::setData(const QByteArray& data) {
+
+  clear();
+  data_ = data;
+  size_ = data.size();
+}
+
+void fileBytes::clear() {
+
+  if (map_) {
+    file_.unmap(map_);
+    map_ = NULL;
+  }
+  if (file_.isOpen()) {
+    file_.close();
+  }
+  fileName_ = QString();
+  offset_ = 0;
+  size_ = 0;
+  fileSize_ = 0;
+  fileModified_ = QDateTime();
+  data_ = QByteArray();
+}
+
+bool fileBytes::available() const {
+
+  if (fileName_.isEmpty() || (!map_ && !data_.isNull())) {
+    return !data_.isNull();
+  }
+  const QFileInfo info(fileName_);
+  return info.exists() && info.size() == fileSize_ &&
+    info.lastModified() == fileModified_;
+}
+
+void fileBytes::detach() {
+
+  if (fileName_.isEmpty()) {
+    return;
+  }
+  QByteArray data;
+  if (!available()) {
+    qWarning() << "Original image file changed" << fileName_;
+  }
+  else if (map_) {
+    data = QByteArray(reinterpret_cast<const char*>(map_), size_);
+  }
+  else if (!data_.isNull()) {
+    data = data_;
+  }
+  else {
+    QFile file(fileName_);
+    if (file.open(QIODevice::ReadOnly) && file.seek(offset_)) {
+      data = file.read(size_);
+    }
+    if (data.size() != size_) {
+      qWarning() << "Unable to read original image file" << fileName_;
+      data = QByteArray();
+    }
+  }
+  setData(data);
+}
+
+bool fileBytes::writeTo(QIODevice* device) const {
+
+  if (map_) {
+    return device->write(reinterpret_cast<const char*>(map_), size_) == size_;
+  }
+  if (!data_.isNull()) {
+    return device->write(data_) == size_;
+  }
+  QFile file(fileName_);
+  if (!file.open(QIODevice::ReadOnly) || !file.seek(offset_)) {
+    return false;
+  }
+  for (qint64 remaining = size_; remaining > 0; ) {
+    const QByteArray chunk = file.read(qMin(remaining, COPY_CHUNK_BYTES));
+    if (chunk.isEmpty() || device->write(chunk) != chunk.size()) {
+      return false;
+    }
+    remaining -= chunk.size();
+  }
+  return true;
+}
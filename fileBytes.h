@@ -0,0 +1,81 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef FILEBYTES_H
+#define FILEBYTES_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+class QIODevice;
+
+// fileBytes holds a run of bytes from a file (for us the user's original
+// image file, either on its own or embedded in a project file) without
+// keeping its own copy when it can avoid it: the bytes are memory mapped
+// if the file system allows it, otherwise they're read into memory if
+// they fit in the "original_image_memory" budget (in megabytes),
+// otherwise they're read back from the file each time they're needed.
+// The bytes can also be given directly, in which case they're held in
+// memory.
+class fileBytes {
+
+ public:
+  fileBytes() : offset_(0), size_(0), fileSize_(0), map_(NULL) {}
+  ~fileBytes() { clear(); }
+  // use the <size> bytes starting at <offset> in <fileName>
+  void setFile(const QString& fileName, qint64 offset, qint64 size);
+  // use <data>
+  void setData(const QByteArray& data);
+  void clear();
+  qint64 size() const { return size_; }
+  // the number of bytes we're holding in memory (mapped bytes are backed
+  // by the file, so they don't count)
+  qint64 memoryBytes() const { return data_.size(); }
+  // the canonical path of the file the bytes come from, or empty if
+  // they're held in memory
+  QString fileName() const { return fileName_; }
+  // return true if the bytes can still be written: they're in memory or
+  // the file they come from hasn't changed since setFile
+  bool available() const;
+  // read the bytes into memory and stop using the file (to be called
+  // before the file is overwritten)
+  void detach();
+  // write the bytes to <device>; return false on failure
+  bool writeTo(QIODevice* device) const;
+
+ private:
+  Q_DISABLE_COPY(fileBytes)
+
+  QString fileName_;
+  qint64 offset_;
+  qint64 size_;
+  // the file's size and modification time at setFile, to check that it
+  // hasn't changed underneath us
+  qint64 fileSize_;
+  QDateTime fileModified_;
+  // open only while mapped
+  QFile file_;
+  uchar* map_;
+  QByteArray data_;
+};
+
+#endif
@@ -0,0 +1,338 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "flossPalette.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+#include <QtCore/QSharedPointer>
+
+// the number of color orders (see colorOrder)
+const int COLOR_ORDER_COUNT = 7;
+// the size of a Lab match table page's cube of rgb colors along each
+// color axis
+const int LAB_PAGE_CELL = 16;
+// the number of page cubes along each color axis
+const int LAB_PAGE_CELLS = 256/LAB_PAGE_CELL;
+// the number of pages and the number of entries in a page
+const int LAB_PAGE_COUNT = LAB_PAGE_CELLS*LAB_PAGE_CELLS*LAB_PAGE_CELLS;
+const int LAB_PAGE_SIZE = LAB_PAGE_CELL*LAB_PAGE_CELL*LAB_PAGE_CELL;
+
+// hand tuned intensity spreads for the built in palettes, indexed by
+// colorOrder (old projects depend on these, so they mustn't change)
+const int DMC_POST_0_9_5_29_SPREADS[COLOR_ORDER_COUNT] =
+  {99, 100, 139, 175, 174, 164, 275};
+const int DMC_PRE_0_9_5_30_SPREADS[COLOR_ORDER_COUNT] =
+  {120, 103, 156, 215, 231, 269, 209};
+const int ANCHOR_SPREADS[COLOR_ORDER_COUNT] =
+  {104, 96, 173, 175, 175, 175, 263};
+
+class paletteSet {
+ public:
+  QSharedPointer<flossPalette> dmc;
+  QSharedPointer<flossPalette> anchor;
+};
+
+// a Lab match table (see flossPalette)
+class labMatchTable {
+
+ public:
+  labMatchTable() {}
+  ~labMatchTable();
+  // return the entry for <color>, allocating its page if necessary
+  QAtomicInteger<quint16>& entry(const triC& color);
+  // the memory used by the table
+  qint64 bytes() const;
+
+ private:
+  Q_DISABLE_COPY(labMatchTable)
+  QAtomicPointer<QAtomicInteger<quint16> > pages_[LAB_PAGE_COUNT];
+};
+
+labMatchTable::~labMatchTable() {
+
+  for (int i = 0; i < LAB_PAGE_COUNT; ++i) {
+    delete [] pages_[i].loadAcquire();
+  }
+}
+
+QAtomicInteger<quint16>& labMatchTable::entry(const triC& color) {
+
+  const int r = color.r(), g = color.g(), b = color.b();
+  QAtomicPointer<QAtomicInteger<quint16> >& pagePointer =
+    pages_[((r/LAB_PAGE_CELL)*LAB_PAGE_CELLS + g/LAB_PAGE_CELL)*
+           LAB_PAGE_CELLS + b/LAB_PAGE_CELL];
+  QAtomicInteger<quint16>* page = pagePointer.loadAcquire();
+  if (!page) {
+    QAtomicInteger<quint16>* newPage =
+      new QAtomicInteger<quint16>[LAB_PAGE_SIZE];
+    if (pagePointer.testAndSetOrdered(NULL, newPage)) {
+      page = newPage;
+    }
+    else {
+      // somebody else got there first
+      delete [] newPage;
+      page = pagePointer.loadAcquire();
+    }
+  }
+  return page[((r%LAB_PAGE_CELL)*LAB_PAGE_CELL + g%LAB_PAGE_CELL)*
+              LAB_PAGE_CELL + b%LAB_PAGE_CELL];
+}
+
+qint64 labMatchTable::bytes() const {
+
+  qint64 bytes = sizeof(*this);
+  for (int i = 0; i < LAB_PAGE_COUNT; ++i) {
+    if (pages_[i].loadAcquire()) {
+      bytes += LAB_PAGE_SIZE*sizeof(QAtomicInteger<quint16>);
+    }
+  }
+  return bytes;
+}
+
+QAtomicPointer<const paletteSet> paletteRegistry::current_;
+QAtomicPointer<const paletteSet> paletteRegistry::snapshots_[2];
+
+// return a new comparator for <order>
+static orderComparator* createComparator(colorOrder order) {
+
+  switch (order) {
+  case O_RGB:
+    return new rgbComparator();
+  case O_RBG:
+    return new rbgComparator();
+  case O_GRB:
+    return new grbComparator();
+  case O_GBR:
+    return new gbrComparator();
+  case O_BGR:
+    return new bgrComparator();
+  case O_BRG:
+    return new brgComparator();
+  case O_GRAY:
+  default:
+    return new grayComparator();
+  }
+}
+
+flossPalette::flossPalette(const QString& name,
+                           const QVector<floss>& flossList,
+                           const QVector<int>& spreads)
+  : name_(name), floss_(flossList), spreads_(spreads) {
+
+  Q_ASSERT(spreads_.size() == COLOR_ORDER_COUNT);
+  colors_.reserve(floss_.size());
+  for (int i = 0, size = floss_.size(); i < size; ++i) {
+    colors_.push_back(floss_[i].color());
+  }
+  buildOrderColors();
+  labColors_ = labColorList(colors_);
+}
+
+flossPalette::~flossPalette() {
+
+  clearLabTables();
+}
+
+const QVector<iColor>& flossPalette::orderColors(colorOrder order) const {
+
+  return orderColors_[order];
+}
+
+triC flossPalette::closestMatch(const triC& color) const {
+
+  const colorMatcher matcher(*this, color);
+  return matcher.closestMatch();
+}
+
+triC flossPalette::labClosestMatch(const triC& color,
+                                   colorMetric metric) const {
+
+  Q_ASSERT(metric != metricRgb);
+  // (a table entry can't hold the index of a larger palette)
+  if (colors_.size() >= 0xffff) {
+    return colors_[labColors_.closestIndex(labColor(color), metric)];
+  }
+  QAtomicPointer<labMatchTable>& tablePointer =
+    labMatches_[metric - metricCie76];
+  labMatchTable* table = tablePointer.loadAcquire();
+  if (!table) {
+    labMatchTable* newTable = new labMatchTable;
+    if (tablePointer.testAndSetOrdered(NULL, newTable)) {
+      table = newTable;
+    }
+    else {
+      // somebody else got there first
+      delete newTable;
+      table = tablePointer.loadAcquire();
+    }
+  }
+  QAtomicInteger<quint16>& entry = table->entry(color);
+  int index = entry.loadAcquire() - 1;
+  if (index < 0) {
+    index = labColors_.closestIndex(labColor(color), metric);
+    entry.storeRelease(static_cast<quint16>(index + 1));
+  }
+  return colors_[index];
+}
+
+qint64 flossPalette::labTableBytes() const {
+
+  qint64 bytes = 0;
+  for (int i = 0; i < 2; ++i) {
+    const labMatchTable* table = labMatches_[i].loadAcquire();
+    if (table) {
+      bytes += table->bytes();
+    }
+  }
+  return bytes;
+}
+
+void flossPalette::clearLabTables() const {
+
+  for (int i = 0; i < 2; ++i) {
+    delete labMatches_[i].fetchAndStoreOrdered(NULL);
+  }
+}
+
+void flossPalette::buildOrderColors() {
+
+  orderColors_ = QVector<QVector<iColor> >(COLOR_ORDER_COUNT);
+  for (int order = 0; order < COLOR_ORDER_COUNT; ++order) {
+    const orderComparator* comparator =
+      createComparator(static_cast<colorOrder>(order));
+    QVector<iColor>& thisList = orderColors_[order];
+    for (int i = 0, size = colors_.size(); i < size; ++i) {
+      if ((*comparator)(colors_[i])) {
+        thisList.push_back(iColor(colors_[i]));
+      }
+    }
+    delete comparator;
+    if (thisList.isEmpty()) {
+      for (int i = 0, size = colors_.size(); i < size; ++i) {
+        thisList.push_back(iColor(colors_[i]));
+      }
+    }
+    std::sort(thisList.begin(), thisList.end());
+  }
+}
+
+const flossPalette& paletteRegistry::palette(flossType type) {
+
+  const paletteSet& palettes = current();
+  switch (type.value()) {
+  case flossDMC:
+    return *palettes.dmc;
+  case flossAnchor:
+    return *palettes.anchor;
+  default:
+    qWarning() << "Unknown floss type in paletteRegistry" << type.value();
+    return *palettes.dmc;
+  }
+}
+
+qint64 paletteRegistry::labTableBytes() {
+
+  // (both snapshots live for the rest of the run, so count both)
+  qint64 bytes = 0;
+  for (int i = 0; i < 2; ++i) {
+    const paletteSet* palettes = snapshots_[i].loadAcquire();
+    if (palettes) {
+      bytes += palettes->dmc->labTableBytes() +
+        palettes->anchor->labTableBytes();
+    }
+  }
+  return bytes;
+}
+
+void paletteRegistry::clearLabTables() {
+
+  for (int i = 0; i < 2; ++i) {
+    const paletteSet* palettes = snapshots_[i].loadAcquire();
+    if (palettes) {
+      palettes->dmc->clearLabTables();
+      palettes->anchor->clearLabTables();
+    }
+  }
+}
+
+void paletteRegistry::initialize() {
+
+  current();
+}
+
+const paletteSet& paletteRegistry::current() {
+
+  const paletteSet* palettes = current_.loadAcquire();
+  if (palettes) {
+    return *palettes;
+  }
+  // (if somebody else got there first then they picked the same snapshot)
+  current_.testAndSetOrdered(NULL, snapshot(::useNewDmcColorList()));
+  return *current_.loadAcquire();
+}
+
+void paletteRegistry::reset() {
+
+  current_.storeRelease(snapshot(::useNewDmcColorList()));
+}
+
+const paletteSet* paletteRegistry::snapshot(bool newDmcList) {
+
+  QAtomicPointer<const paletteSet>& snapshotPointer =
+    snapshots_[newDmcList ? 1 : 0];
+  const paletteSet* palettes = snapshotPointer.loadAcquire();
+  if (palettes) {
+    return palettes;
+  }
+  const paletteSet* newPalettes = createPaletteSet(newDmcList);
+  if (snapshotPointer.testAndSetOrdered(NULL, newPalettes)) {
+    return newPalettes;
+  }
+  // somebody else got there first
+  delete newPalettes;
+  return snapshotPointer.loadAcquire();
+}
+
+const paletteSet* paletteRegistry::createPaletteSet(bool newDmcList) {
+
+  paletteSet* palettes = new paletteSet;
+  // (I'm not certain that old projects would recreate the same colors if
+  // we mess with the spreads, so they're set based on version)
+  const int* dmcSpreads = newDmcList ?
+    DMC_POST_0_9_5_29_SPREADS : DMC_PRE_0_9_5_30_SPREADS;
+  QVector<int> spreads;
+  for (int i = 0; i < COLOR_ORDER_COUNT; ++i) {
+    spreads.push_back(dmcSpreads[i]);
+  }
+  const QVector<floss> dmcFloss = newDmcList ?
+    ::initializePost0_9_5_29DMC() : ::initializePre0_9_5_30DMC();
+  palettes->dmc =
+    QSharedPointer<flossPalette>(new flossPalette("DMC", dmcFloss, spreads));
+  spreads.clear();
+  for (int i = 0; i < COLOR_ORDER_COUNT; ++i) {
+    spreads.push_back(ANCHOR_SPREADS[i]);
+  }
+  palettes->anchor =
+    QSharedPointer<flossPalette>(new flossPalette("Anchor",
+                                                  ::initializeAnchor(),
+                                                  spreads));
+  return palettes;
+}
@@ -0,0 +1,154 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef FLOSSPALETTE_H
+#define FLOSSPALETTE_H
+
+#include <QtCore/QAtomicInteger>
+#include <QtCore/QAtomicPointer>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "colorDistance.h"
+#include "colorLists.h"
+#include "floss.h"
+
+class labMatchTable;
+
+// flossPalette is a named list of floss (one floss brand's colors, say)
+// together with the data colorMatcher needs to quickly find the palette
+// color closest to a given color.
+//
+//// Implementation notes
+//
+// Matching only considers palette colors with the same color order as the
+// input color (see colorMatcher).  For each color order the palette keeps
+// its colors of that order sorted by intensity, plus an intensity spread:
+// a bound on how far the intensity of the closest match can be from the
+// input's intensity, so that a match only has to scan an intensity band
+// (the spreads are hand tuned, and old projects depend on them, so they
+// can't change).  All of this is built by the constructor and never
+// changes afterwards, so a palette can be matched against from any number
+// of threads.
+//
+// Lab matching searches the palette using its precomputed Lab values
+// (see labColorList), and remembers each answer in a table with an entry
+// for every rgb color, so an rgb color's match is only ever searched for
+// once.  A table is split into pages, one for each 16x16x16 cube of rgb
+// colors, and a page is only allocated the first time a color in its
+// cube is matched, so an image with a few thousand colors costs a few
+// pages rather than the 32MB a full table would.  Entries are atomic and
+// hold the index of the match plus one (zero until it's been found), and
+// pages are installed with an atomic swap, so threads can fill the table
+// concurrently without locking.
+//
+class flossPalette {
+
+ public:
+  // a palette with the given intensity <spreads>, indexed by colorOrder
+  flossPalette(const QString& name, const QVector<floss>& flossList,
+               const QVector<int>& spreads);
+  ~flossPalette();
+  QString name() const { return name_; }
+  const QVector<floss>& flossList() const { return floss_; }
+  const QVector<triC>& colors() const { return colors_; }
+  // the palette colors with color order <order>, sorted by intensity (all
+  // of the palette colors if none have that order)
+  const QVector<iColor>& orderColors(colorOrder order) const;
+  // the intensity spread to use when matching a color with color order
+  // <order>
+  int intensitySpread(colorOrder order) const { return spreads_[order]; }
+  // return the palette color closest to <color>
+  triC closestMatch(const triC& color) const;
+  // return the palette color closest to <color> under the Lab <metric>
+  triC labClosestMatch(const triC& color, colorMetric metric) const;
+  // the memory used by the Lab match tables allocated so far
+  qint64 labTableBytes() const;
+  // free the Lab match tables; only call this while nothing is matching
+  // against the palette
+  void clearLabTables() const;
+
+ private:
+  Q_DISABLE_COPY(flossPalette)
+  // build orderColors_ from colors_
+  void buildOrderColors();
+
+  QString name_;
+  QVector<floss> floss_;
+  QVector<triC> colors_;
+  // indexed by colorOrder
+  QVector<QVector<iColor> > orderColors_;
+  QVector<int> spreads_;
+  // the Lab values of colors_
+  labColorList labColors_;
+  // the Lab match tables, indexed by metric - metricCie76
+  mutable QAtomicPointer<labMatchTable> labMatches_[2];
+};
+
+// the palettes in effect for one project version (see paletteRegistry)
+class paletteSet;
+
+// paletteRegistry holds the palettes colorMatcher matches against: the
+// built in DMC palette for the current project version and the built in
+// Anchor palette.
+//
+//// Implementation notes
+//
+// The built in palettes are kept in an immutable paletteSet snapshot that
+// readers get with a single atomic load, so lookups never lock.  There
+// are only two snapshots, one for each DMC list; each is built the first
+// time its list is used and is never freed (a reader on another thread
+// may be using it at any time), and reset() just swaps current_ to the
+// other one.  Picking a snapshot reads the project version, so the first
+// one should be picked on the gui thread, with initialize().
+//
+class paletteRegistry {
+
+ public:
+  // return the built in palette for <type> (DMC for flossVariable)
+  static const flossPalette& palette(flossType type);
+  // the memory used by the palettes' Lab match tables
+  static qint64 labTableBytes();
+  // free the palettes' Lab match tables (to time matching with cold
+  // tables, say); only call this while nothing is matching
+  static void clearLabTables();
+  // build the registry now if it hasn't been built yet
+  static void initialize();
+  // swap in new built in palettes if the current project version uses a
+  // different DMC list than the current palettes; not thread safe with
+  // respect to other resets
+  static void reset();
+
+ private:
+  // return the current snapshot, building the first one if necessary
+  static const paletteSet& current();
+  // return the snapshot for the new (post 0.9.5.29) DMC list if
+  // <newDmcList>, otherwise the one for the old list, building it if
+  // necessary
+  static const paletteSet* snapshot(bool newDmcList);
+  // return a new snapshot for the new DMC list if <newDmcList>, otherwise
+  // for the old list
+  static const paletteSet* createPaletteSet(bool newDmcList);
+
+  static QAtomicPointer<const paletteSet> current_;
+  // the snapshots for the old and new DMC lists, indexed by newDmcList
+  static QAtomicPointer<const paletteSet> snapshots_[2];
+};
+
+#endif
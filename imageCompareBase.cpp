@@ -963,6 +963,19 @@ void imageCompareBase::addRightImageMenuAction(QAction* action) {
   rightImageMenu_->addAction(action);
 }
 
+memoryUsage imageCompareBase::imagesMemory() const {
+
+  memoryUsage usage;
+  const QList<imagePtr> imageList = images();
+  for (int i = 0, size = imageList.size(); i < size; ++i) {
+    const imagePtr thisImage = imageList[i];
+    if (!thisImage->isOriginal()) {
+      usage.add(thisImage->name(), thisImage->memory());
+    }
+  }
+  return usage;
+}
+
 void imageCompareBase::appendCurrentSettings(QDomDocument* doc,
                                              QDomElement* appendee) const {
 
@@ -237,6 +237,7 @@ class imageCompareBase : public imageSaverWindow {
   void appendCurrentSettings(QDomDocument* doc,
                              QDomElement* appendee) const; //override;
   QString updateCurrentSettings(const QDomElement& settings); //override;
+  memoryUsage imagesMemory() const; //override;
 
  protected:
   // set the current image to <container> and update subwidgets to reflect
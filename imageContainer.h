@@ -22,12 +22,15 @@
 
 #include <QtCore/QSharedData>
 #include <QtCore/QMetaType>
+#include <QtCore/QObject>
 #include <QtCore/QSize>
 
 #include <QtGui/QImage>
 
 #include "triC.h"
 #include "floss.h"
+#include "imagePyramid.h"
+#include "memoryUsage.h"
 
 extern const int ZOOM_INCREMENT;
 
@@ -85,6 +88,9 @@ class imageContainer : public QSharedData {
   // Return the floss type of the initial color list.
   flossType flossMode() const { return flossType_; }
   virtual const QImage& image() const = 0;
+  // derived classes whose image never changes should hold a pyramid
+  // for their image and return it here
+  virtual imagePyramid pyramid() const { return imagePyramid(image()); }
   virtual QImage scaledImage() const {
     return image().scaled(scaledSize_, Qt::IgnoreAspectRatio);
   }
@@ -93,6 +99,12 @@ class imageContainer : public QSharedData {
   QSize originalSize() const { return image().size(); }
   virtual QVector<triC> colors() const = 0;
   virtual QVector<flossColor> flossColors() const = 0;
+  // return the memory held by this container's image and its other data
+  virtual memoryUsage memory() const {
+    memoryUsage usage;
+    usage.add(QObject::tr("Image"), memoryUsage::imageBytes(image()));
+    return usage;
+  }
 
  private:
   QString name_;
@@ -110,9 +122,11 @@ class mutableImageContainer : public imageContainer {
  public:
   mutableImageContainer(const QString& imageName, const QImage& image,
                         const QVector<triC>& colors, flossType type)
-    : imageContainer(imageName, image.size(), type), image_(image),
+    : imageContainer(imageName, image.size(), type), image_(image, true),
     colors_(colors) {}
-  const QImage& image() const { return image_; }
+  const QImage& image() const { return image_.image(); }
+  imagePyramid pyramid() const { return image_; }
+  QImage scaledImage() const { return image_.scaled(scaledSize()); }
   QVector<triC> colors() const { return colors_; }
   QVector<flossColor> flossColors() const {
     QVector<flossColor> returnVector;
@@ -122,28 +136,41 @@ class mutableImageContainer : public imageContainer {
     }
     return returnVector;
   }
+  memoryUsage memory() const {
+    memoryUsage usage(imageContainer::memory());
+    usage.add(QObject::tr("Zoom levels"), image_.levelBytes());
+    usage.add(QObject::tr("Color list"), colors_.size() * sizeof(triC));
+    return usage;
+  }
   bool isOriginal() const { return false; }
 
  private:
-  const QImage image_;
+  const imagePyramid image_;
   QVector<triC> colors_;
 };
 
-// immutableImageContainer copies a _const_ _reference_ to its image and
-// guarantees that the reference image will not be altered.
+// immutableImageContainer shares the pyramid of its (original) image and
+// guarantees that the image will not be altered.
 class immutableImageContainer : public imageContainer {
 
  public:
- immutableImageContainer(const QString& imageName, const QImage& image)
+ immutableImageContainer(const QString& imageName, const imagePyramid& image)
    : imageContainer(imageName, image.size(), flossVariable),
      image_(image) {}
-  const QImage& image() const { return image_; }
+  const QImage& image() const { return image_.image(); }
+  imagePyramid pyramid() const { return image_; }
+  QImage scaledImage() const { return image_.scaled(scaledSize()); }
   QVector<triC> colors() const { return QVector<triC>(); }
   QVector<flossColor> flossColors() const { return QVector<flossColor>(); }
+  memoryUsage memory() const {
+    memoryUsage usage(imageContainer::memory());
+    usage.add(QObject::tr("Zoom levels"), image_.levelBytes());
+    return usage;
+  }
   bool isOriginal() const { return true; }
 
  private:
-  const QImage& image_;
+  const imagePyramid image_;
 };
 
 #endif
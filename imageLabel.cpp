@@ -54,64 +54,92 @@ void imageLabelBase::mouseReleaseEvent(QMouseEvent* event) {
 }
 
 imageLabel::imageLabel(QWidget* parent)
-  : imageLabelBase(parent), originalImage_(QPixmap()), scaledImage_(QPixmap()) {
+  : imageLabelBase(parent), originalSize_(0, 0), scaledSize_(0, 0) {
 
   // don't clear window before painting
   setAttribute(Qt::WA_OpaquePaintEvent);
 }
 
-imageLabel::imageLabel(const QPixmap& image, QWidget* parent)
-  : imageLabelBase(parent), originalImage_(image), scaledImage_(image) {
+imageLabel::imageLabel(const imagePyramid& image, QWidget* parent)
+  : imageLabelBase(parent), originalImage_(image),
+    originalSize_(image.size()), scaledSize_(image.size()) {
 
   // don't clear window before painting if there's no transparency
   setAttribute(Qt::WA_OpaquePaintEvent, !originalImage_.hasAlpha());
-  resize(image.width(), image.height());
+  resize(scaledSize_);
 }
 
 void imageLabel::paintEvent(QPaintEvent* event) {
 
+  if (originalImage_.isNull() || scaledSize_.isEmpty()) {
+    event->accept();
+    return;
+  }
   QPainter painter(this);
   //painter.setRenderHint(QPainter::SmoothPixmapTransform);
 
-  const QRectF viewRectangle(QRectF(event->rect()));
-  painter.drawPixmap(viewRectangle, scaledImage_, viewRectangle);
+  // map the exposed rectangle back onto the closest pyramid level and let
+  // the painter scale just that piece
+  const QImage& level = originalImage_.level(scaledSize_);
+  const qreal xScale = static_cast<qreal>(level.width())/scaledSize_.width();
+  const qreal yScale =
+    static_cast<qreal>(level.height())/scaledSize_.height();
+  const QRectF viewRectangle =
+    QRectF(event->rect()).intersected(QRectF(QPointF(0, 0), scaledSize_));
+  const QRectF sourceRectangle(viewRectangle.x() * xScale,
+                               viewRectangle.y() * yScale,
+                               viewRectangle.width() * xScale,
+                               viewRectangle.height() * yScale);
+  painter.drawImage(viewRectangle, level, sourceRectangle);
   event->accept();
 }
 
-void imageLabel::setImageAndSize(const QPixmap& image) {
+void imageLabel::setImageAndSize(const imagePyramid& image) {
 
   originalImage_ = image;
   setAttribute(Qt::WA_OpaquePaintEvent, !originalImage_.hasAlpha());
-  scaledImage_ = image;
-  resize(scaledImage_.width(), scaledImage_.height());
+  originalSize_ = image.size();
+  scaledSize_ = image.size();
+  resize(scaledSize_);
   update();
 }
 
-void imageLabel::updateImage(const QPixmap& image, const QRect& rectangle) {
+void imageLabel::updateImage(const imagePyramid& image,
+                             const QRect& rectangle) {
 
   originalImage_ = image;
+  if (originalSize_.isEmpty()) {
+    originalSize_ = image.size();
+  }
   setAttribute(Qt::WA_OpaquePaintEvent, !originalImage_.hasAlpha());
-  scaledImage_ = originalImage_.scaled(scaledImage_.size());
   rectangle.isNull() ? update() : update(rectangle);
 }
 
 void imageLabel::setImageWidth(int width) {
 
-  scaledImage_ = originalImage_.scaledToWidth(width);
-  resize(scaledImage_.width(), scaledImage_.height());
-  update();
+  if (originalImage_.isNull() || width < 1) {
+    return;
+  }
+  const int height =
+    qMax(1, qRound(originalSize_.height() * static_cast<qreal>(width)/
+                   originalSize_.width()));
+  setImageSize(QSize(width, height));
 }
 
 void imageLabel::setImageHeight(int height) {
 
-  scaledImage_ = originalImage_.scaledToHeight(height);
-  resize(scaledImage_.width(), scaledImage_.height());
-  update();
+  if (originalImage_.isNull() || height < 1) {
+    return;
+  }
+  const int width =
+    qMax(1, qRound(originalSize_.width() * static_cast<qreal>(height)/
+                   originalSize_.height()));
+  setImageSize(QSize(width, height));
 }
 
 void imageLabel::setImageSize(const QSize& size) {
 
-  scaledImage_ = originalImage_.scaled(size);
-  resize(scaledImage_.size());
+  scaledSize_ = size;
+  resize(scaledSize_);
   update();
 }
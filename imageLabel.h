@@ -22,6 +22,8 @@
 
 #include <QtWidgets/QWidget>
 
+#include "imagePyramid.h"
+
 class imageLabelBase : public QWidget {
 
   Q_OBJECT
@@ -60,7 +62,10 @@ class imageLabelBase : public QWidget {
 //
 //// Implementation notes
 //
-// imageLabel holds its image as a QPixmap for quick display.
+// imageLabel holds its image as an imagePyramid and only keeps the
+// current scaled size - there is no scaled copy of the image.  Each paint
+// event draws just the exposed rectangle, sampled from the closest
+// pyramid level, so memory use doesn't grow with the zoom level.
 // The image is actually painted on the widget (not displayed on a QLabel).
 // If mouseTracking is on then this widget emits signals for mouse presses,
 // releases, and moves.
@@ -71,21 +76,28 @@ class imageLabel : public imageLabelBase {
 
  public:
   explicit imageLabel(QWidget* parent);
-  imageLabel(const QPixmap& image, QWidget* parent);
+  imageLabel(const imagePyramid& image, QWidget* parent);
   bool imageIsNull() const { return originalImage_.isNull(); }
   // the current scaled width
-  int width() const { return scaledImage_.width(); }
+  int width() const { return scaledSize_.width(); }
   // the current scaled height
-  int height() const { return scaledImage_.height(); }
-  QSize size() const { return scaledImage_.size(); }
-  int originalWidth() const { return originalImage_.width(); }
-  int originalHeight() const { return originalImage_.height(); }
+  int height() const { return scaledSize_.height(); }
+  QSize size() const { return scaledSize_; }
+  // the size of the image as set by the constructor or setImageAndSize
+  int originalWidth() const { return originalSize_.width(); }
+  int originalHeight() const { return originalSize_.height(); }
   void setMouseTracking(bool b) { QWidget::setMouseTracking(b); }
   // set a new <image> and redraw the <rectangle> portion of the widget,
-  // but don't change the current image size settings
-  void updateImage(const QPixmap& image, const QRect& rectangle = QRect());
+  // but don't change the current image size settings: <image> is only
+  // what gets painted, stretched to the current size, so it may be a
+  // smaller stand-in (a preview, say) for an image of the original size
+  void updateImage(const imagePyramid& image,
+                   const QRect& rectangle = QRect());
+  void updateImage(const QImage& image, const QRect& rectangle = QRect()) {
+    updateImage(imagePyramid(image), rectangle);
+  }
   // sets a new image and resets the size settings to <image>
-  void setImageAndSize(const QPixmap& image);
+  void setImageAndSize(const imagePyramid& image);
   // change the displayed image width to <width> and set height to maintain
   // the aspect ratio
   void setImageWidth(int width);
@@ -93,12 +105,14 @@ class imageLabel : public imageLabelBase {
   void setImageSize(const QSize& size);
 
  protected:
-  // draws the image at the current size setting
+  // draws the exposed part of the image at the current size setting
   virtual void paintEvent(QPaintEvent* event);
 
  private:
-  QPixmap originalImage_;
-  QPixmap scaledImage_;
+  imagePyramid originalImage_;
+  // the size the zoom settings are relative to
+  QSize originalSize_;
+  QSize scaledSize_; // the size the image is displayed at
 };
 
 #endif
@@ -21,14 +21,15 @@
 
 #include <algorithm>
 
-#include <QtCore/QTime>
 #include <QtCore/QStack>
 
+#include "colorDistance.h"
 #include "colorLists.h"
 #include "grid.h"
 #include "utility.h"
 #include "imageUtility.h"
 #include "versionProcessing.h"
+#include "trace.h"
 
 // max ::ds distance between two colors
 extern const int D_MAX = 766;
@@ -40,6 +41,56 @@ extern const int D_SUM_MAX = 16777216;
 extern const int PROGRESS_X_COORDINATE = 300;
 extern const int PROGRESS_Y_COORDINATE = 250;
 
+// set the <width>x<height> rectangle with upper left corner
+// (<xStart>, <yStart>) in <image> to <color>; writes 32 bit images a
+// scanline at a time, the same as setPixel would
+static inline void fillRectangle(QImage* image, int xStart, int yStart,
+                                 int width, int height, QRgb color) {
+
+  const QImage::Format format = image->format();
+  const int yEnd = yStart + height;
+  if (format == QImage::Format_RGB32 || format == QImage::Format_ARGB32) {
+    const QRgb value =
+      (format == QImage::Format_RGB32) ? (0xff000000 | color) : color;
+    for (int j = yStart; j < yEnd; ++j) {
+      QRgb* line = reinterpret_cast<QRgb*>(image->scanLine(j)) + xStart;
+      std::fill(line, line + width, value);
+    }
+  }
+  else {
+    const int xEnd = xStart + width;
+    for (int j = yStart; j < yEnd; ++j) {
+      for (int i = xStart; i < xEnd; ++i) {
+        image->setPixel(i, j, color);
+      }
+    }
+  }
+}
+
+// set the <dimension>x<dimension> block with upper left corner
+// (<xStart>, <yStart>) in <image> to <color>
+static inline void fillBlock(QImage* image, int xStart, int yStart,
+                             int dimension, QRgb color) {
+
+  fillRectangle(image, xStart, yStart, dimension, dimension, color);
+}
+
+// return the index of the color on <colors> closest to <color> (by ds)
+static inline int closestColorIndex(const triC& color,
+                                    const QVector<triC>& colors) {
+
+  int min = D_MAX;
+  int chosenIndex = 0;
+  for (int k = 0, size = colors.size(); k < size; ++k) {
+    const int thisD = ::ds(color, colors[k]);
+    if (thisD < min) {
+      min = thisD;
+      chosenIndex = k;
+    }
+  }
+  return chosenIndex;
+}
+
 colorTransformerPtr
 colorTransformer::createColorTransformer(flossType type) {
 
@@ -64,7 +115,12 @@ void segment(const QImage& sourceImage, QImage* newImage,
              const QList<pixel>& squaresList, int dim,
              const QVector<triC>& colors) {
 
-  const int colorListSize = colors.size();
+  const colorMetric metric = colorDistance::metric();
+  // Lab matching is too slow to repeat for every pixel, so remember the
+  // match for each source color
+  const labColorList labColors =
+    (metric == metricRgb) ? labColorList() : labColorList(colors);
+  QHash<QRgb, int> labMatches;
   for (QList<pixel>::const_iterator it = squaresList.constBegin(),
         end = squaresList.constEnd(); it != end; ++it) {
     const int xStart = (*it).x() * dim;
@@ -74,13 +130,20 @@ void segment(const QImage& sourceImage, QImage* newImage,
     for (int i = xStart; i < xEnd; ++i) {
       for (int j = yStart; j < yEnd; ++j) {
         const QRgb thisColor = sourceImage.pixel(i, j);
-        int min = D_MAX;
         int chosenIndex = 0;
-        for (int k = 0; k < colorListSize; ++k) {
-          const int tmpMin = ds(thisColor, colors[k]);
-          if (tmpMin < min) {
-            min = tmpMin;
-            chosenIndex = k;
+        if (metric == metricRgb) {
+          chosenIndex = ::closestColorIndex(thisColor, colors);
+        }
+        else {
+          const QHash<QRgb, int>::const_iterator foundIt =
+            labMatches.constFind(thisColor);
+          if (foundIt != labMatches.constEnd()) {
+            chosenIndex = *foundIt;
+          }
+          else {
+            chosenIndex =
+              labColors.closestIndex(labColor(triC(thisColor)), metric);
+            labMatches.insert(thisColor, chosenIndex);
           }
         }
         newImage->setPixel(i, j, colors[chosenIndex].qrgb());
@@ -96,9 +159,11 @@ QVector<triC> segment(QImage* newImage, const QVector<triC>& colors,
     qWarning() << "Empty color list in segment.";
     return QVector<triC>();
   }
-  //QTime t;
-  //t.start();
+  const traceSpan span("segment");
 
+  const colorMetric metric = colorDistance::metric();
+  const labColorList labColors =
+    (metric == metricRgb) ? labColorList() : labColorList(colors);
   QSet<QRgb> colorsUsed;
   colorsUsed.reserve(colors.size());
   const int width = newImage->width();
@@ -131,15 +196,9 @@ QVector<triC> segment(QImage* newImage, const QVector<triC>& colors,
         chosenQRgbColor = *foundIt;
       }
       else {
-        int min = D_MAX;
-        int chosenIndex = 0;
-        for (int k = 0, size = colors.size(); k < size; ++k) {
-          const int thisD = ::ds(thisColor, colors[k]);
-          if (thisD < min) {
-            min = thisD;
-            chosenIndex = k;
-          }
-        }
+        const int chosenIndex = (metric == metricRgb) ?
+          ::closestColorIndex(thisColor, colors) :
+          labColors.closestIndex(labColor(triC(thisColor)), metric);
         chosenQRgbColor = colors[chosenIndex].qrgb();
         colorMap[thisColor] = chosenQRgbColor;
         colorsUsed.insert(chosenQRgbColor);
@@ -152,7 +211,6 @@ QVector<triC> segment(QImage* newImage, const QVector<triC>& colors,
          end = colorsUsed.end(); it != end; ++it) {
     returnColors.push_back(triC(*it));
   }
-  //  qDebug() << "segment time:" << double(t.elapsed())/1000.;
   return returnColors;
 }
 
@@ -374,8 +432,7 @@ QVector<triC> chooseColors(const QImage& image, int numColors,
                            int numImageColors,
                            const colorTransformerPtr& transformer) {
 
-//  QTime t;
-//  t.start();
+  traceSpan span("chooseColors: count");
   const int width = image.width();
   const int height = image.height();
   altMeter progressMeter(QObject::tr("Choosing colors Step 1/2..."),
@@ -404,7 +461,7 @@ QVector<triC> chooseColors(const QImage& image, int numColors,
       i += count - 1;
     }
   }
-  //qDebug() << "First count time: " << double(t.elapsed())/1000.;
+  span.restart("chooseColors: choose");
   QVector<QRgb> seedRgbColors;
   seedRgbColors.reserve(seedColors.size());
   for (int i = 0, size = seedColors.size(); i < size; ++i) {
@@ -448,8 +505,7 @@ QVector<triC> chooseColorsFromList(const QHash<QRgb, int>& colorCountMap,
   toDmc.reserve(colorCountMap.size());
   QHash<QRgb, int> dmcCountMap; // counts of dmc colors
   dmcCountMap.reserve(DMC_POST_0_9_5_29_COUNT);
-  QTime t;
-  t.start();
+  traceSpan span("chooseColorsFromList: recount");
   altMeter progressMeter(QObject::tr("Choosing colors Step 2/2..."),
                          QObject::tr("Cancel"), 0, colorCountMap.size()/64);
   progressMeter.setMinimumDuration(1000);
@@ -491,11 +547,9 @@ QVector<triC> chooseColorsFromList(const QHash<QRgb, int>& colorCountMap,
                                      it.value() +
                                      dmcCountMap[toDmc[it.key()]]));
   }
-  //  qDebug() << "cchoose colors recount:" << double(t.elapsed())/1000.;
-  t.restart();
+  span.restart("chooseColorsFromList: sort");
   std::sort(colorCounts.begin(), colorCounts.end(), qGreater<colorCount>());
-  //qDebug() << "Sort time:" << double(t.elapsed())/1000.;
-  t.restart();
+  span.restart("chooseColorsFromList: choose");
   QVector<QRgb> returnColors = seedColors;
   returnColors.reserve(numColors);
   // TODO: should base separation on the spread of the colors
@@ -555,7 +609,6 @@ QVector<triC> chooseColorsFromList(const QHash<QRgb, int>& colorCountMap,
       minCount = 0;
     }
   }
-  //qDebug() << "Actual choose time:" << double(t.elapsed())/1000.;
   QVector<triC> tricReturnColors;
   tricReturnColors.reserve(returnColors.size());
   for (int i = 0, size = returnColors.size(); i < size; ++i) {
@@ -576,13 +629,7 @@ QVector<pairOfInts> changeColor(QImage* newImage, QRgb oldColor,
       int xStart = boxX * dimension;
       int yStart = boxY * dimension;
       if (newImage->pixel(xStart, yStart) == oldColor) {
-        int xEnd = xStart + dimension;
-        int yEnd = yStart + dimension;
-        for (int j = yStart; j < yEnd; ++j) {
-          for (int i = xStart; i < xEnd; ++i) {
-            newImage->setPixel(i, j, newColor);
-          }
-        }
+        fillBlock(newImage, xStart, yStart, dimension, newColor);
         returnCoords.push_back(pairOfInts(xStart/dimension,
                                           yStart/dimension));
       }
@@ -594,24 +641,16 @@ QVector<pairOfInts> changeColor(QImage* newImage, QRgb oldColor,
 void changeOneBlock(QImage* newImage, int x, int y, QRgb newColor,
                     int dimension, bool blockCoords) {
 
-  int xStart, xEnd, yStart, yEnd;
+  int xStart, yStart;
   if (blockCoords == false) {
     xStart = (x / dimension)*dimension;
-    xEnd = xStart + dimension;
     yStart = (y / dimension)*dimension;
-    yEnd = yStart + dimension;
   }
   else {
     xStart = x*dimension;
-    xEnd = xStart + dimension;
     yStart = y*dimension;
-    yEnd = yStart + dimension;
-  }
-  for (int j = yStart; j < yEnd; ++j) {
-    for (int i = xStart; i < xEnd; ++i) {
-      newImage->setPixel(i, j, newColor);
-    }
   }
+  fillBlock(newImage, xStart, yStart, dimension, newColor);
 }
 
 template<class T>
@@ -631,13 +670,7 @@ void changeBlocks(QImage* newImage, const QVector<T>& points,
       xStart = x*dimension;
       yStart = y*dimension;
     }
-    int xEnd = xStart + dimension;
-    int yEnd = yStart + dimension;
-    for (int j = yStart; j < yEnd; ++j) {
-      for (int i = xStart; i < xEnd; ++i) {
-        newImage->setPixel(i, j, newColor);
-      }
-    }
+    fillBlock(newImage, xStart, yStart, dimension, newColor);
   }
 }
 template void changeBlocks<pairOfInts>(QImage* newImage,
@@ -663,14 +696,105 @@ void changeBlocks(QImage* newImage, const QVector<pixel>& pixels,
       xStart = x*dimension;
       yStart = y*dimension;
     }
-    int xEnd = xStart + dimension;
-    int yEnd = yStart + dimension;
-    QRgb newColor = (*it).color();
-    for (int j = yStart; j < yEnd; ++j) {
-      for (int i = xStart; i < xEnd; ++i) {
-        newImage->setPixel(i, j, newColor);
+    fillBlock(newImage, xStart, yStart, dimension, (*it).color());
+  }
+}
+
+void applyColorChanges(QImage* newImage, const QList<colorChange>& changes,
+                       int dimension, bool reverse) {
+
+  // (row, column, color) for each square, sorted so that we visit the
+  // squares in image order
+  int squareCount = 0;
+  for (int i = 0, size = changes.size(); i < size; ++i) {
+    squareCount += changes[i].coordinates().size();
+  }
+  QVector<QPair<quint64, QRgb> > squares;
+  squares.reserve(squareCount);
+  for (int i = 0, size = changes.size(); i < size; ++i) {
+    const colorChange& thisChange = changes[i];
+    const QRgb color =
+      reverse ? thisChange.oldColor() : thisChange.newColor();
+    const QVector<pairOfInts> coordinates = thisChange.coordinates();
+    for (int j = 0, jSize = coordinates.size(); j < jSize; ++j) {
+      const quint64 position =
+        (static_cast<quint64>(coordinates[j].y()) << 32) |
+        static_cast<quint32>(coordinates[j].x());
+      squares.push_back(qMakePair(position, color));
+    }
+  }
+  std::sort(squares.begin(), squares.end());
+  for (int i = 0, size = squares.size(); i < size; ++i) {
+    const int xBox = static_cast<int>(squares[i].first & 0xffffffff);
+    const int yBox = static_cast<int>(squares[i].first >> 32);
+    fillBlock(newImage, xBox * dimension, yBox * dimension, dimension,
+              squares[i].second);
+  }
+}
+
+QImage squareColorImage(const QImage& image, int dimension) {
+
+  const int widthSquares = image.width()/dimension;
+  const int heightSquares = image.height()/dimension;
+  QImage squareColors(widthSquares, heightSquares, QImage::Format_RGB32);
+  for (int yBox = 0; yBox < heightSquares; ++yBox) {
+    QRgb* line = reinterpret_cast<QRgb*>(squareColors.scanLine(yBox));
+    for (int xBox = 0; xBox < widthSquares; ++xBox) {
+      line[xBox] = image.pixel(xBox * dimension, yBox * dimension);
+    }
+  }
+  return squareColors;
+}
+
+void drawSquareColorImage(QImage* newImage, const QImage& squareColors,
+                          int dimension) {
+
+  for (int yBox = 0, height = squareColors.height(); yBox < height; ++yBox) {
+    const QRgb* line =
+      reinterpret_cast<const QRgb*>(squareColors.constScanLine(yBox));
+    for (int xBox = 0, width = squareColors.width(); xBox < width; ++xBox) {
+      fillBlock(newImage, xBox * dimension, yBox * dimension, dimension,
+                line[xBox]);
+    }
+  }
+}
+
+// a horizontal run of squares [xStart, xEnd] in square row y
+class squareSpan {
+ public:
+  squareSpan() : y_(0), xStart_(0), xEnd_(0) {}
+  squareSpan(int y, int xStart, int xEnd)
+    : y_(y), xStart_(xStart), xEnd_(xEnd) {}
+  int y() const { return y_; }
+  int xStart() const { return xStart_; }
+  int xEnd() const { return xEnd_; }
+  bool operator<(const squareSpan& other) const {
+    return y_ < other.y_ || (y_ == other.y_ && xStart_ < other.xStart_);
+  }
+ private:
+  int y_;
+  int xStart_;
+  int xEnd_;
+};
+
+// push a seed square onto <seeds> for each run of <oldColor> squares in
+// square row <y> between columns <xStart> and <xEnd>
+static void pushSpanSeeds(const QImage& image, int xStart, int xEnd, int y,
+                          QRgb oldColor, int dimension,
+                          QStack<pairOfInts>* seeds) {
+
+  bool inRun = false;
+  const int yPixel = y * dimension;
+  for (int x = xStart; x <= xEnd; ++x) {
+    if (image.pixel(x * dimension, yPixel) == oldColor) {
+      if (!inRun) {
+        seeds->push(pairOfInts(x, y));
+        inRun = true;
       }
     }
+    else {
+      inRun = false;
+    }
   }
 }
 
@@ -682,109 +806,55 @@ QVector<pairOfInts> fillRegion(QImage* newImage, int x, int y,
     return QVector<pairOfInts>();
   }
 
-  newImage->setPixel(x, y, newColor);
-  const int width = newImage->width();
-  const int height = newImage->height();
-  // a stack of squares the neighbors of which are still being checked
-  QStack<pairOfInts> coordStack;
+  // work on squares: a square is unfilled as long as its upper left
+  // pixel is still oldColor
+  const int widthSquares = newImage->width()/dimension;
+  const int heightSquares = newImage->height()/dimension;
+  QStack<pairOfInts> seeds;
+  seeds.push(pairOfInts(x/dimension, y/dimension));
+  QVector<squareSpan> spans;
+  int squareCount = 0;
+  while (!seeds.isEmpty()) {
+    const pairOfInts seed = seeds.pop();
+    const int seedY = seed.y();
+    const int yPixel = seedY * dimension;
+    if (newImage->pixel(seed.x() * dimension, yPixel) != oldColor) {
+      continue; // already filled from another seed
+    }
+    // extend the seed left and right as far as it goes
+    int xStart = seed.x();
+    while (xStart > 0 &&
+           newImage->pixel((xStart - 1) * dimension, yPixel) == oldColor) {
+      --xStart;
+    }
+    int xEnd = seed.x();
+    while (xEnd < widthSquares - 1 &&
+           newImage->pixel((xEnd + 1) * dimension, yPixel) == oldColor) {
+      ++xEnd;
+    }
+    fillRectangle(newImage, xStart * dimension, yPixel,
+                  (xEnd - xStart + 1) * dimension, dimension, newColor);
+    spans.push_back(squareSpan(seedY, xStart, xEnd));
+    squareCount += xEnd - xStart + 1;
+    if (seedY > 0) {
+      pushSpanSeeds(*newImage, xStart, xEnd, seedY - 1, oldColor, dimension,
+                    &seeds);
+    }
+    if (seedY < heightSquares - 1) {
+      pushSpanSeeds(*newImage, xStart, xEnd, seedY + 1, oldColor, dimension,
+                    &seeds);
+    }
+  }
+
+  // return the squares in row order so that the history's runs of
+  // squares stay together
+  std::sort(spans.begin(), spans.end());
   QVector<pairOfInts> returnSquares;
-  int i = (x/dimension)*dimension;
-  int j = (y/dimension)*dimension;
-  coordStack.push(pairOfInts(i, j));
-  returnSquares.push_back(pairOfInts(i/dimension, j/dimension));
-  for (int jj = j, jjStop = jj + dimension; jj < jjStop; ++jj) {
-    for (int ii = i, iiStop = ii + dimension; ii < iiStop; ++ii) {
-      newImage->setPixel(ii, jj, newColor);
-    }
-  }
-  while (1) {
-    // for each direction...
-    while (1) { // right
-      while (1) { // left
-        while (1) { // down
-          while (1) { // up
-            const int newJ = j - dimension;
-            if (newJ >= 0 && newImage->pixel(i, newJ) == oldColor) {
-              for (int jj = newJ, jjStop = newJ + dimension; jj < jjStop;
-                   ++jj) {
-                for (int ii = i, iiStop = i + dimension; ii < iiStop;
-                     ++ii) {
-                  newImage->setPixel(ii, jj, newColor);
-                }
-              }
-              j = newJ;
-              coordStack.push(pairOfInts(i, j));
-              returnSquares.push_back(pairOfInts(i/dimension, j/dimension));
-            }
-            else {
-              break;
-            }
-          } // end up
-          const int newJ = j + dimension;
-          if (newJ < height && newImage->pixel(i, newJ) == oldColor) {
-            for (int jj = newJ, jjStop = newJ + dimension; jj < jjStop;
-                 ++jj) {
-              for (int ii = i, iiStop = i + dimension; ii < iiStop; ++ii) {
-                newImage->setPixel(ii, jj, newColor);
-              }
-            }
-            j = newJ;
-            coordStack.push(pairOfInts(i, j));
-            returnSquares.push_back(pairOfInts(i/dimension, j/dimension));
-          }
-          else {
-            break;
-          }
-        } // end down
-        const int newI = i - dimension;
-        if (newI >= 0 && newImage->pixel(newI, j) == oldColor) {
-          for (int jj = j, jjStop = j + dimension; jj < jjStop; ++jj) {
-            for (int ii = newI, iiStop = newI + dimension; ii < iiStop;
-                 ++ii) {
-              newImage->setPixel(ii, jj, newColor);
-            }
-          }
-          i = newI;
-          coordStack.push(pairOfInts(i, j));
-          returnSquares.push_back(pairOfInts(i/dimension, j/dimension));
-        }
-        else {
-          break;
-        }
-      } // end left
-      const int newI = i + dimension;
-      if (newI < width && newImage->pixel(newI, j) == oldColor) {
-        for (int jj = j, jjStop = j + dimension; jj < jjStop; ++jj) {
-          for (int ii = newI, iiStop = newI + dimension; ii < iiStop;
-               ++ii) {
-            newImage->setPixel(ii, jj, newColor);
-          }
-        }
-        i = newI;
-        coordStack.push(pairOfInts(i, j));
-        returnSquares.push_back(pairOfInts(i/dimension, j/dimension));
-      }
-      else {
-        break;
-      }
-    } // end right
-
-    const int iLeft = i - dimension;
-    const int iRight = i + dimension;
-    const int jUp = j - dimension;
-    const int jDown = j + dimension;
-    if ((iLeft < 0 || newImage->pixel(iLeft, j) != oldColor) &&
-        (iRight >= width || newImage->pixel(iRight, j) != oldColor) &&
-        (jUp < 0 || newImage->pixel(i, jUp) != oldColor) &&
-        (jDown >= height || newImage->pixel(i, jDown) != oldColor)) {
-      coordStack.pop();
-      if (!coordStack.isEmpty()) {
-        i = coordStack.top().x();
-        j = coordStack.top().y();
-      }
-      else {
-        break;
-      }
+  returnSquares.reserve(squareCount);
+  for (int i = 0, size = spans.size(); i < size; ++i) {
+    const squareSpan& span = spans[i];
+    for (int xBox = span.xStart(); xBox <= span.xEnd(); ++xBox) {
+      returnSquares.push_back(pairOfInts(xBox, span.y()));
     }
   }
   return returnSquares;
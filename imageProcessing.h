@@ -31,6 +31,7 @@ class triC;
 class pixel;
 class historyPixel;
 class pairOfInts;
+class colorChange;
 class QImage;
 template<class T> class QVector;
 template<class T> class QList;
@@ -227,11 +228,28 @@ void changeBlocks(QImage* newImage, const QVector<T>& points,
 void changeBlocks(QImage* newImage, const QVector<pixel>& pixels,
                   int dimension, bool blockCoords = false);
 
+// for each of <changes>, change the squares (of dimension <dimension>) at
+// its (box) coordinates to its new color, or to its old color if
+// <reverse>.  All of the changes are made in a single top to bottom pass
+// over <newImage>.
+void applyColorChanges(QImage* newImage, const QList<colorChange>& changes,
+                       int dimension, bool reverse = false);
+
+// return an image with one pixel for each <dimension>x<dimension> square
+// of <image>, colored the same as the square
+QImage squareColorImage(const QImage& image, int dimension);
+
+// set each <dimension>x<dimension> square of <newImage> to the color of
+// the corresponding pixel of <squareColors> (the inverse of
+// squareColorImage)
+void drawSquareColorImage(QImage* newImage, const QImage& squareColors,
+                          int dimension);
+
 // fill in the region including (<x>,<y>) with <newColor>, where each
 // square has dimension <dimension>.  The region is determined by moving
 // up, down, left, right, but _not_ diagonal.  (<x>, <y> are pixel
 // coordinates, not square.)
-// returns the square coordinates of the squares filled
+// returns the square coordinates of the squares filled, in row order
 QVector<pairOfInts> fillRegion(QImage* newImage, int x, int y,
                                QRgb newColor, int dimension);
 
@@ -0,0 +1,147 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "imagePyramid.h"
+#include "memoryUsage.h"
+
+#include <QtCore/QRect>
+#include <QtCore/QtMath>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+// don't halve a level that's smaller than this in either dimension
+const int MIN_LEVEL_DIMENSION = 128;
+
+// return <image> repeatedly halved until it gets down to around
+// MIN_LEVEL_DIMENSION, or nothing once <cancelled> is set (halve with the
+// same fast scaling the display has always used so that zooming out
+// looks the same as it did without levels)
+static QVector<QImage> buildLevels(QImage image,
+                                   QSharedPointer<QAtomicInt> cancelled) {
+
+  QVector<QImage> levels;
+  while (image.width() >= 2*MIN_LEVEL_DIMENSION &&
+         image.height() >= 2*MIN_LEVEL_DIMENSION) {
+    if (cancelled->loadAcquire()) {
+      return QVector<QImage>();
+    }
+    image = image.scaled(image.width()/2, image.height()/2,
+                         Qt::IgnoreAspectRatio, Qt::FastTransformation);
+    levels.push_back(image);
+  }
+  return levels;
+}
+
+imagePyramid::imagePyramid() : d_(new pyramidData) {}
+
+imagePyramid::imagePyramid(const QImage& image, bool withLevels)
+  : d_(new pyramidData) {
+
+  d_->image = image;
+  d_->levelsWanted = withLevels &&
+    image.width() >= 2*MIN_LEVEL_DIMENSION &&
+    image.height() >= 2*MIN_LEVEL_DIMENSION;
+}
+
+void imagePyramid::startLevels(const QSize& size) const {
+
+  // (the first level is half the image)
+  if (d_->levelsWanted && 2*size.width() <= d_->image.width() &&
+      2*size.height() <= d_->image.height()) {
+    d_->levelsWanted = false;
+    d_->levelsPending = true;
+    d_->levelsCancelled = QSharedPointer<QAtomicInt>(new QAtomicInt(0));
+    d_->levelsFuture = QtConcurrent::run(::buildLevels, d_->image,
+                                         d_->levelsCancelled);
+  }
+}
+
+void imagePyramid::collectLevels() const {
+
+  if (d_->levelsPending && d_->levelsFuture.isFinished()) {
+    d_->levels = d_->levelsFuture.result();
+    d_->levelsFuture = QFuture<QVector<QImage> >();
+    d_->levelsCancelled.clear();
+    d_->levelsPending = false;
+  }
+}
+
+QImage imagePyramid::scaled(const QSize& size) const {
+
+  return scaled(d_->image.rect(), size);
+}
+
+const QImage& imagePyramid::level(const QSize& size) const {
+
+  startLevels(size);
+  collectLevels();
+  const QImage* level = &d_->image;
+  for (int i = 0, count = d_->levels.size(); i < count; ++i) {
+    const QImage& candidate = d_->levels[i];
+    if (candidate.width() < size.width() ||
+        candidate.height() < size.height()) {
+      break;
+    }
+    level = &candidate;
+  }
+  return *level;
+}
+
+qint64 imagePyramid::levelBytes() const {
+
+  collectLevels();
+  qint64 bytes = 0;
+  for (int i = 0, count = d_->levels.size(); i < count; ++i) {
+    bytes += memoryUsage::imageBytes(d_->levels[i]);
+  }
+  return bytes;
+}
+
+QImage imagePyramid::scaled(const QRect& source, const QSize& size) const {
+
+  const QImage& image = d_->image;
+  if (image.isNull() || source.isEmpty() || size.isEmpty()) {
+    return QImage();
+  }
+  // use the smallest level that still has at least <size> pixels covering
+  // <source>
+  const QImage& level =
+    this->level(QSize(qCeil(static_cast<qreal>(size.width()) *
+                            image.width()/source.width()),
+                      qCeil(static_cast<qreal>(size.height()) *
+                            image.height()/source.height())));
+
+  if (&level == &image) {
+    if (source == image.rect()) {
+      return image.scaled(size);
+    }
+    return image.copy(source).scaled(size);
+  }
+  const qreal xScale = static_cast<qreal>(level.width())/image.width();
+  const qreal yScale = static_cast<qreal>(level.height())/image.height();
+  const QRect levelSource =
+    QRect(qRound(source.x() * xScale), qRound(source.y() * yScale),
+          qMax(1, qRound(source.width() * xScale)),
+          qMax(1, qRound(source.height() * yScale))).
+    intersected(level.rect());
+  if (levelSource == level.rect()) {
+    return level.scaled(size);
+  }
+  return level.copy(levelSource).scaled(size);
+}
@@ -0,0 +1,105 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef IMAGEPYRAMID_H
+#define IMAGEPYRAMID_H
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QFuture>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
+#include <QtGui/QImage>
+
+class QRect;
+
+// imagePyramid holds an image together with successively halved copies
+// of it, so that scaling the image down for display can start from the
+// closest level instead of from the full image every time.  Copies of
+// a pyramid share the image and its levels.
+//
+//// Implementation notes
+//
+// The image itself is level 0 (implicitly shared, so it isn't copied).
+// Only pyramids for long lived images (the original image and the color
+// compare images) get smaller levels: a pyramid made for an image that's
+// about to be replaced (an edited square image, say) would just waste
+// the work of halving it.  The levels are built by a QtConcurrent job
+// that's started the first time a level at most half the image's size is
+// asked for, and are picked up the first time they're needed after that
+// job finishes; until then requests are served from the image.  The job
+// checks a shared flag between halvings and gives up once the last copy
+// of its pyramid is gone.  A pyramid is only for use from the gui thread.
+//
+class imagePyramid {
+
+ public:
+  imagePyramid();
+  // a pyramid for <image>, which only gets smaller levels if
+  // <withLevels>; only ask for levels for an image that will be around
+  // for a while
+  explicit imagePyramid(const QImage& image, bool withLevels = false);
+  const QImage& image() const { return d_->image; }
+  bool isNull() const { return d_->image.isNull(); }
+  int width() const { return d_->image.width(); }
+  int height() const { return d_->image.height(); }
+  QSize size() const { return d_->image.size(); }
+  bool hasAlpha() const { return d_->image.hasAlpha(); }
+  // return the smallest level that is at least as large as <size> (the
+  // image itself if no level is or the levels aren't ready yet)
+  const QImage& level(const QSize& size) const;
+  // the bytes held by the levels below the image (0 if they haven't
+  // been built yet)
+  qint64 levelBytes() const;
+  // return the image scaled to <size>
+  QImage scaled(const QSize& size) const;
+  // return the <source> portion of the image scaled to <size>
+  QImage scaled(const QRect& source, const QSize& size) const;
+
+ private:
+  // start the background job that builds the levels if <size> could use
+  // one and it hasn't been started yet
+  void startLevels(const QSize& size) const;
+  // pick up the levels from the background job if it's finished
+  void collectLevels() const;
+
+ private:
+  struct pyramidData {
+    pyramidData() : levelsWanted(false), levelsPending(false) {}
+    // tell a running levels job that nobody wants its levels
+    ~pyramidData() {
+      if (levelsCancelled) {
+        levelsCancelled->storeRelease(1);
+      }
+    }
+    QImage image;
+    // levels[i] is image halved i+1 times
+    QVector<QImage> levels;
+    QFuture<QVector<QImage> > levelsFuture;
+    // shared with the levels job, set to non-zero to stop it
+    QSharedPointer<QAtomicInt> levelsCancelled;
+    // true if the levels job should be started when a level is needed
+    bool levelsWanted;
+    // true if levelsFuture still has levels for us
+    bool levelsPending;
+  };
+  QSharedPointer<pyramidData> d_;
+};
+
+#endif
@@ -74,20 +74,26 @@ void gridImage(QImage* image, int originalSquareDim,
     return;
   }
 
-  QPainter painter(image);
-  painter.setPen(QPen(QColor(gridColor), gridLineWidth));
+  // collect all of the lines first so that they can be drawn with a single
+  // drawLines call instead of one drawLine per line
+  QVector<QLine> lines;
+  lines.reserve(static_cast<int>(newWidth/xdim + newHeight/ydim) + 4);
   for (qreal i = 0; i < newWidth; i += xdim) {
     const int iInt = static_cast<int>(i);
-    painter.drawLine(QPoint(iInt, 0), QPoint(iInt, newHeight));
+    lines.push_back(QLine(iInt, 0, iInt, newHeight));
   }
   for (qreal j = 0; j < newHeight; j += ydim) {
     const int jInt = static_cast<int>(j);
-    painter.drawLine(QPoint(0, jInt), QPoint(newWidth, jInt));
+    lines.push_back(QLine(0, jInt, newWidth, jInt));
   }
   // grid lines are drawn on the left/top sides of squares, so we have
   // to do the final right/bottom ones by hand
-  painter.drawLine(QPoint(newWidth-1, 0), QPoint(newWidth-1, newHeight));
-  painter.drawLine(QPoint(0, newHeight-1), QPoint(newWidth, newHeight-1));
+  lines.push_back(QLine(newWidth-1, 0, newWidth-1, newHeight));
+  lines.push_back(QLine(0, newHeight-1, newWidth, newHeight-1));
+
+  QPainter painter(image);
+  painter.setPen(QPen(QColor(gridColor), gridLineWidth));
+  painter.drawLines(lines);
 }
 
 int computeGridForImageFit(const QSize& imageSize,
@@ -39,6 +39,7 @@
 #include "helpBrowser.h"
 #include "quickHelp.h"
 #include "floss.h"
+#include "memoryUsage.h"
 
 extern const int ZOOM_INCREMENT = 100;
 
@@ -254,7 +255,9 @@ void imageZoomWindow::displayOriginalImageInfo(int width, int height) {
                            tr("The original image currently has dimensions "
                               "%1x%2 and contains %n color(s).", "", colorCount)
                            .arg(::itoqs(width))
-                           .arg(::itoqs(height)));
+                           .arg(::itoqs(height)) +
+                           imageInfoMemoryString(windowManager_->
+                                                 originalImageMemory()));
 }
 
 void imageZoomWindow::setStatus(const QString& status) {
@@ -388,6 +391,14 @@ void imageZoomWindow::addQuickHelp(QAction* autoShowQuickHelp) {
   helpMenu_->insertAction(quickHelpAction_, autoShowQuickHelp);
 }
 
+void imageZoomWindow::addRecordTrace(QAction* recordTrace) {
+  helpMenu_->insertAction(helpAboutAction_, recordTrace);
+}
+
+void imageZoomWindow::addMemoryUsage(QAction* memoryUsage) {
+  helpMenu_->insertAction(helpAboutAction_, memoryUsage);
+}
+
 void imageZoomWindow::showListDock() { dockHolder_->show(); }
 
 void imageZoomWindow::hideListDock() { dockHolder_->hide(); }
@@ -459,4 +470,15 @@ QString imageZoomWindow::imageInfoFlossString(flossType type) const {
     return "";
   }
 }
+
+QString imageZoomWindow::imageInfoMemoryString(const memoryUsage& usage)
+  const {
+
+  return "\n\n" + tr("Memory use:") + "\n" + usage.toString();
+}
+
+memoryUsage imageZoomWindow::imagesMemory() const {
+
+  return memoryUsage();
+}
   
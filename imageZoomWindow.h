@@ -30,6 +30,7 @@ class QString;
 class QLabel;
 class QMenu;
 class flossType;
+class memoryUsage;
 
 extern const int ZOOM_INCREMENT;
 
@@ -57,6 +58,10 @@ class imageZoomWindow : public QMainWindow {
   // on/off (common to all windows), we just put it on our help menu and
   // forget about it (promise)
   void addQuickHelp(QAction* autoShowQuickHelp);
+  // same as addQuickHelp, for the action that turns timing traces on/off
+  void addRecordTrace(QAction* recordTrace);
+  // same as addQuickHelp, for the action that shows the memory summary
+  void addMemoryUsage(QAction* memoryUsage);
   // windowManager manages these menus, we just display them (promise)
   void addRecentlyOpenedMenus(QMenu* imagesMenu, QMenu* projectsMenu);
   // show <status> in the normal (left) part of the status bar for
@@ -138,6 +143,11 @@ class imageZoomWindow : public QMainWindow {
   virtual void processFirstShow();
   // Return a text string for image info display on colors of type <type>.
   QString imageInfoFlossString(flossType type) const;
+  // Return a text paragraph for image info display listing <usage>.
+  QString imageInfoMemoryString(const memoryUsage& usage) const;
+  // return the memory held by each of this window's images other than the
+  // original, listed by image name
+  virtual memoryUsage imagesMemory() const;
 
  protected slots:
   // reset image(s) to original size
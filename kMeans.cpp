@@ -0,0 +1,549 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#include "kMeans.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QThread>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <QtGui/QImage>
+
+#include "colorDistance.h"
+#include "trace.h"
+#include "utility.h"
+
+// the number of bits of each color channel the color histogram keeps
+const int HISTOGRAM_BITS = 5;
+const int HISTOGRAM_SIZE = 1 << (3*HISTOGRAM_BITS);
+// give up on converging after this many iterations
+const int MAX_ITERATIONS = 30;
+// we've converged once no center moves farther than this (squared)
+const float CONVERGED_DISTANCE = 0.25f;
+// the coordinate used to pad the centers (far enough from every color
+// that it's never closest)
+const float PADDING_COORDINATE = 1.0e6f;
+
+// the pixels in one color histogram bin
+class histogramBin {
+ public:
+  histogramBin() : count(0), r(0), g(0), b(0) {}
+  qint64 count;
+  // the sum of each channel over the bin's pixels
+  qint64 r;
+  qint64 g;
+  qint64 b;
+};
+
+// rows [yStart, yEnd) of a 32 bit <image> to histogram
+class histogramJob {
+ public:
+  histogramJob(const QImage* image, int yStart, int yEnd)
+    : image(image), yStart(yStart), yEnd(yEnd) {}
+  const QImage* image;
+  int yStart;
+  int yEnd;
+};
+
+// the colors being clustered (the mean color of each non-empty histogram
+// bin), weighted by their pixel counts
+class pointSet {
+ public:
+  void add(float r, float g, float b, float weight) {
+    rs.push_back(r);
+    gs.push_back(g);
+    bs.push_back(b);
+    weights.push_back(weight);
+  }
+  int size() const { return rs.size(); }
+  // 0, 1, 2 for r, g, b
+  const QVector<float>& channel(int channel) const {
+    return (channel == 0) ? rs : ((channel == 1) ? gs : bs);
+  }
+  QVector<float> rs;
+  QVector<float> gs;
+  QVector<float> bs;
+  QVector<float> weights;
+};
+
+// cluster centers
+class centerSet {
+ public:
+  void add(float r, float g, float b) {
+    rs.push_back(r);
+    gs.push_back(g);
+    bs.push_back(b);
+  }
+  int size() const { return rs.size(); }
+  // this set padded to a multiple of four with far away centers (for
+  // closestPointIndex)
+  centerSet padded() const {
+    centerSet returnSet(*this);
+    while (returnSet.size() % 4 != 0) {
+      returnSet.add(PADDING_COORDINATE, PADDING_COORDINATE,
+                    PADDING_COORDINATE);
+    }
+    return returnSet;
+  }
+  QVector<float> rs;
+  QVector<float> gs;
+  QVector<float> bs;
+};
+
+// points [start, end) to assign to the closest of <centers> (padded, with
+// <centerCount> real centers)
+class assignmentJob {
+ public:
+  assignmentJob(const pointSet* points, const centerSet* centers,
+                int centerCount, int start, int end)
+    : points(points), centers(centers), centerCount(centerCount),
+      start(start), end(end) {}
+  const pointSet* points;
+  const centerSet* centers;
+  int centerCount;
+  int start;
+  int end;
+};
+
+// the weighted sums of the points assigned to each center
+class clusterSums {
+ public:
+  clusterSums() {}
+  explicit clusterSums(int size)
+    : rs(size, 0), gs(size, 0), bs(size, 0), weights(size, 0) {}
+  // add <other>'s sums to ours
+  void add(const clusterSums& other) {
+    for (int i = 0, size = rs.size(); i < size; ++i) {
+      rs[i] += other.rs[i];
+      gs[i] += other.gs[i];
+      bs[i] += other.bs[i];
+      weights[i] += other.weights[i];
+    }
+  }
+  QVector<double> rs;
+  QVector<double> gs;
+  QVector<double> bs;
+  QVector<double> weights;
+};
+
+// compares point indices by one channel of the points
+class pointChannelLess {
+ public:
+  explicit pointChannelLess(const QVector<float>& values) : values_(values) {}
+  bool operator()(int i, int j) const { return values_[i] < values_[j]; }
+ private:
+  const QVector<float>& values_;
+};
+
+// compares cluster indices by decreasing cluster weight
+class clusterWeightGreater {
+ public:
+  explicit clusterWeightGreater(const QVector<double>& weights)
+    : weights_(weights) {}
+  bool operator()(int i, int j) const { return weights_[i] > weights_[j]; }
+ private:
+  const QVector<double>& weights_;
+};
+
+// return the histogram of the rows of <job>
+static QVector<histogramBin> histogramRows(const histogramJob& job) {
+
+  QVector<histogramBin> bins(HISTOGRAM_SIZE);
+  histogramBin* binData = bins.data();
+  const int shift = 8 - HISTOGRAM_BITS;
+  const int width = job.image->width();
+  for (int y = job.yStart; y < job.yEnd; ++y) {
+    const QRgb* line =
+      reinterpret_cast<const QRgb*>(job.image->constScanLine(y));
+    for (int x = 0; x < width; ++x) {
+      const int r = qRed(line[x]);
+      const int g = qGreen(line[x]);
+      const int b = qBlue(line[x]);
+      histogramBin& bin = binData[((r >> shift) << (2*HISTOGRAM_BITS)) |
+                                  ((g >> shift) << HISTOGRAM_BITS) |
+                                  (b >> shift)];
+      ++bin.count;
+      bin.r += r;
+      bin.g += g;
+      bin.b += b;
+    }
+  }
+  return bins;
+}
+
+// return the sums of the points of <job> by closest center
+static clusterSums assignPoints(const assignmentJob& job) {
+
+  const pointSet& points = *job.points;
+  const float* rs = job.centers->rs.constData();
+  const float* gs = job.centers->gs.constData();
+  const float* bs = job.centers->bs.constData();
+  const int paddedSize = job.centers->size();
+  clusterSums sums(job.centerCount);
+  for (int i = job.start; i < job.end; ++i) {
+    const float r = points.rs[i];
+    const float g = points.gs[i];
+    const float b = points.bs[i];
+    const double weight = points.weights[i];
+    const int center = ::closestPointIndex(rs, gs, bs, paddedSize, r, g, b);
+    sums.rs[center] += weight*r;
+    sums.gs[center] += weight*g;
+    sums.bs[center] += weight*b;
+    sums.weights[center] += weight;
+  }
+  return sums;
+}
+
+// return [start, end) ranges splitting [0, <size>) into one range for
+// each thread
+static QList<QPair<int, int> > threadRanges(int size) {
+
+  const int threadCount = qMax(1, QThread::idealThreadCount());
+  QList<QPair<int, int> > ranges;
+  for (int i = 0; i < threadCount; ++i) {
+    const int start = static_cast<qint64>(size)*i/threadCount;
+    const int end = static_cast<qint64>(size)*(i + 1)/threadCount;
+    if (end > start) {
+      ranges.push_back(qMakePair(start, end));
+    }
+  }
+  return ranges;
+}
+
+// return the weighted colors of <image> (a 32 bit image), one for each
+// non-empty histogram bin
+static pointSet imagePoints(const QImage& image) {
+
+  QList<histogramJob> jobs;
+  const QList<QPair<int, int> > ranges = threadRanges(image.height());
+  for (int i = 0, size = ranges.size(); i < size; ++i) {
+    jobs.push_back(histogramJob(&image, ranges[i].first, ranges[i].second));
+  }
+  const QList<QVector<histogramBin> > jobBins =
+    QtConcurrent::blockingMapped(jobs, histogramRows);
+  pointSet points;
+  for (int i = 0; i < HISTOGRAM_SIZE; ++i) {
+    histogramBin bin;
+    for (int j = 0, size = jobBins.size(); j < size; ++j) {
+      const histogramBin& thisBin = jobBins[j][i];
+      bin.count += thisBin.count;
+      bin.r += thisBin.r;
+      bin.g += thisBin.g;
+      bin.b += thisBin.b;
+    }
+    if (bin.count > 0) {
+      const float count = static_cast<float>(bin.count);
+      points.add(bin.r/count, bin.g/count, bin.b/count, count);
+    }
+  }
+  return points;
+}
+
+// add the weighted means of (up to) <count> boxes of <points> to
+// <centers>, where the boxes come from repeatedly cutting the box with the
+// largest weighted squared error along one channel at its weighted median
+// along that channel
+static void medianCut(const pointSet& points, int count, centerSet* centers) {
+
+  QVector<int> order(points.size());
+  for (int i = 0, size = order.size(); i < size; ++i) {
+    order[i] = i;
+  }
+  // [start, end) ranges of order
+  QList<QPair<int, int> > boxes;
+  if (!order.isEmpty()) {
+    boxes.push_back(qMakePair(0, order.size()));
+  }
+  while (boxes.size() < count) {
+    int cutBox = -1;
+    int cutChannel = 0;
+    double maxError = 0;
+    for (int box = 0, size = boxes.size(); box < size; ++box) {
+      const int start = boxes[box].first;
+      const int end = boxes[box].second;
+      if (end - start < 2) {
+        continue;
+      }
+      for (int channel = 0; channel < 3; ++channel) {
+        const QVector<float>& values = points.channel(channel);
+        double weight = 0;
+        double sum = 0;
+        for (int i = start; i < end; ++i) {
+          weight += points.weights[order[i]];
+          sum += points.weights[order[i]]*values[order[i]];
+        }
+        const double mean = sum/weight;
+        double error = 0;
+        for (int i = start; i < end; ++i) {
+          const double difference = values[order[i]] - mean;
+          error += points.weights[order[i]]*difference*difference;
+        }
+        if (error > maxError) {
+          maxError = error;
+          cutBox = box;
+          cutChannel = channel;
+        }
+      }
+    }
+    if (cutBox == -1) {
+      break; // every box is a single color
+    }
+    const int start = boxes[cutBox].first;
+    const int end = boxes[cutBox].second;
+    std::sort(order.begin() + start, order.begin() + end,
+              pointChannelLess(points.channel(cutChannel)));
+    double halfWeight = 0;
+    for (int i = start; i < end; ++i) {
+      halfWeight += points.weights[order[i]];
+    }
+    halfWeight /= 2;
+    // cut after the weighted median, keeping both halves non-empty
+    int cut = start + 1;
+    double weight = points.weights[order[start]];
+    while (cut < end - 1 && weight < halfWeight) {
+      weight += points.weights[order[cut]];
+      ++cut;
+    }
+    boxes[cutBox] = qMakePair(start, cut);
+    boxes.push_back(qMakePair(cut, end));
+  }
+  for (int box = 0, size = boxes.size(); box < size; ++box) {
+    double weight = 0;
+    double r = 0;
+    double g = 0;
+    double b = 0;
+    for (int i = boxes[box].first; i < boxes[box].second; ++i) {
+      const int point = order[i];
+      weight += points.weights[point];
+      r += points.weights[point]*points.rs[point];
+      g += points.weights[point]*points.gs[point];
+      b += points.weights[point]*points.bs[point];
+    }
+    centers->add(r/weight, g/weight, b/weight);
+  }
+}
+
+// add (up to) <count> of <points> to <centers>, each time choosing the
+// point with the largest weighted squared distance to its closest center
+static void addFarthestPoints(const pointSet& points, int count,
+                              centerSet* centers) {
+
+  if (count <= 0) {
+    return;
+  }
+  QVector<float> minDistances(points.size(), FLT_MAX);
+  if (centers->size() > 0) {
+    const centerSet padded = centers->padded();
+    for (int i = 0, size = points.size(); i < size; ++i) {
+      const int center =
+        ::closestPointIndex(padded.rs.constData(), padded.gs.constData(),
+                            padded.bs.constData(), padded.size(),
+                            points.rs[i], points.gs[i], points.bs[i]);
+      const float dr = points.rs[i] - padded.rs[center];
+      const float dg = points.gs[i] - padded.gs[center];
+      const float db = points.bs[i] - padded.bs[center];
+      minDistances[i] = dr*dr + dg*dg + db*db;
+    }
+  }
+  for (int added = 0; added < count; ++added) {
+    int farthestPoint = -1;
+    double maxCost = 0;
+    for (int i = 0, size = points.size(); i < size; ++i) {
+      const double cost =
+        static_cast<double>(points.weights[i])*minDistances[i];
+      if (cost > maxCost) {
+        maxCost = cost;
+        farthestPoint = i;
+      }
+    }
+    if (farthestPoint == -1) {
+      return; // every point is a center
+    }
+    const float r = points.rs[farthestPoint];
+    const float g = points.gs[farthestPoint];
+    const float b = points.bs[farthestPoint];
+    centers->add(r, g, b);
+    for (int i = 0, size = points.size(); i < size; ++i) {
+      const float dr = points.rs[i] - r;
+      const float dg = points.gs[i] - g;
+      const float db = points.bs[i] - b;
+      minDistances[i] = qMin(minDistances[i], dr*dr + dg*dg + db*db);
+    }
+  }
+}
+
+// return the sums of <points> by closest of <centers>, computed in
+// parallel over <ranges> of the points
+static clusterSums assignAllPoints(const pointSet& points,
+                                   const centerSet& centers,
+                                   const QList<QPair<int, int> >& ranges) {
+
+  const centerSet paddedCenters = centers.padded();
+  QList<assignmentJob> jobs;
+  for (int i = 0, size = ranges.size(); i < size; ++i) {
+    jobs.push_back(assignmentJob(&points, &paddedCenters, centers.size(),
+                                 ranges[i].first, ranges[i].second));
+  }
+  const QList<clusterSums> jobSums =
+    QtConcurrent::blockingMapped(jobs, assignPoints);
+  clusterSums sums(centers.size());
+  for (int i = 0, size = jobSums.size(); i < size; ++i) {
+    sums.add(jobSums[i]);
+  }
+  return sums;
+}
+
+QVector<triC> kMeansColors(const QImage& image, int numColors,
+                           const QVector<triC>& seedColors,
+                           const QVector<triC>& startCentroids,
+                           const colorTransformerPtr& transformer,
+                           QVector<triC>* centroids) {
+
+  traceSpan span("kMeansColors: histogram");
+  QVector<triC> returnColors = seedColors;
+  const int fixedCount = seedColors.size();
+  const int generatedCount = numColors - fixedCount;
+  if (generatedCount <= 0) {
+    return returnColors;
+  }
+  altMeter progressMeter(QObject::tr("Choosing colors..."),
+                         QObject::tr("Cancel"), 0, MAX_ITERATIONS);
+  progressMeter.setMinimumDuration(1000);
+  progressMeter.show();
+
+  const bool is32Bit = image.format() == QImage::Format_RGB32 ||
+    image.format() == QImage::Format_ARGB32;
+  const pointSet points = ::imagePoints(is32Bit ? image :
+                                        image.convertToFormat(QImage::
+                                                              Format_RGB32));
+  if (progressMeter.wasCanceled()) {
+    return QVector<triC>();
+  }
+
+  //// the seeds are fixed centers at the front of centers, followed by the
+  //// centers that move
+  span.restart("kMeansColors: start");
+  centerSet centers;
+  for (int i = 0; i < fixedCount; ++i) {
+    centers.add(seedColors[i].r(), seedColors[i].g(), seedColors[i].b());
+  }
+  if (startCentroids.isEmpty()) {
+    ::medianCut(points, generatedCount, &centers);
+  }
+  else {
+    for (int i = 0, size = qMin(startCentroids.size(), generatedCount);
+         i < size; ++i) {
+      centers.add(startCentroids[i].r(), startCentroids[i].g(),
+                  startCentroids[i].b());
+    }
+  }
+  ::addFarthestPoints(points, fixedCount + generatedCount - centers.size(),
+                      &centers);
+
+  //// iterate: assign each point to its closest center (in parallel), then
+  //// move each center to the mean of its points
+  span.restart("kMeansColors: iterate");
+  const QList<QPair<int, int> > ranges = threadRanges(points.size());
+  QVector<double> clusterWeights;
+  bool reseeded = false;
+  for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+    if (progressMeter.wasCanceled()) {
+      return QVector<triC>();
+    }
+    progressMeter.setValue(iteration);
+    const clusterSums sums = ::assignAllPoints(points, centers, ranges);
+    clusterWeights = sums.weights;
+    float maxMove = 0;
+    // the moved centers (and the fixed ones), and the empty clusters
+    centerSet movedCenters;
+    for (int i = 0; i < fixedCount; ++i) {
+      movedCenters.add(centers.rs[i], centers.gs[i], centers.bs[i]);
+    }
+    QVector<int> emptyClusters;
+    for (int i = fixedCount, size = centers.size(); i < size; ++i) {
+      const double weight = sums.weights[i];
+      if (weight > 0) {
+        const float r = sums.rs[i]/weight;
+        const float g = sums.gs[i]/weight;
+        const float b = sums.bs[i]/weight;
+        const float dr = r - centers.rs[i];
+        const float dg = g - centers.gs[i];
+        const float db = b - centers.bs[i];
+        maxMove = qMax(maxMove, dr*dr + dg*dg + db*db);
+        centers.rs[i] = r;
+        centers.gs[i] = g;
+        centers.bs[i] = b;
+        movedCenters.add(r, g, b);
+      }
+      else {
+        emptyClusters.push_back(i);
+      }
+    }
+    // move every empty cluster to a different worst fit point
+    reseeded = false;
+    if (!emptyClusters.isEmpty()) {
+      const int movedCount = movedCenters.size();
+      ::addFarthestPoints(points, emptyClusters.size(), &movedCenters);
+      for (int i = movedCount, size = movedCenters.size(); i < size; ++i) {
+        const int cluster = emptyClusters[i - movedCount];
+        centers.rs[cluster] = movedCenters.rs[i];
+        centers.gs[cluster] = movedCenters.gs[i];
+        centers.bs[cluster] = movedCenters.bs[i];
+        reseeded = true;
+      }
+    }
+    if (!reseeded && maxMove <= CONVERGED_DISTANCE) {
+      break;
+    }
+  }
+  if (reseeded) {
+    // (we ran out of iterations right after reseeding, so the weights are
+    // from before the reseeding)
+    clusterWeights = ::assignAllPoints(points, centers, ranges).weights;
+  }
+
+  //// transform the centers, largest cluster first
+  span.restart("kMeansColors: transform");
+  QVector<int> order;
+  for (int i = fixedCount, size = centers.size(); i < size; ++i) {
+    if (clusterWeights[i] > 0) {
+      order.push_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   clusterWeightGreater(clusterWeights));
+  centroids->clear();
+  for (int i = 0, size = order.size(); i < size; ++i) {
+    const int center = order[i];
+    const triC centroid(qBound(0, qRound(centers.rs[center]), 255),
+                        qBound(0, qRound(centers.gs[center]), 255),
+                        qBound(0, qRound(centers.bs[center]), 255));
+    centroids->push_back(centroid);
+    const triC newColor = transformer->transform(centroid);
+    if (!returnColors.contains(newColor)) {
+      returnColors.push_back(newColor);
+    }
+  }
+  return returnColors;
+}
@@ -0,0 +1,48 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+
+#ifndef KMEANS_H
+#define KMEANS_H
+
+#include <QtCore/QVector>
+
+#include "colorLists.h"
+#include "triC.h"
+
+class QImage;
+
+// choose (up to) <numColors> colors for <image>, <seedColors> included, by
+// k-means clustering the image's colors weighted by their counts: the
+// seeds are fixed cluster centers and the rest start from
+// <startCentroids> (the <centroids> of an earlier run, so that a run for a
+// nearby number of colors converges quickly) or, if there aren't any, from
+// a median cut of the colors.  The generated colors are transformed by
+// <transformer> (duplicates are dropped).
+// Sets <centroids> to the final centers of the generated colors, before
+// transformation, largest cluster first.
+// Returns the chosen colors, seeds first, or an empty list if the user
+// canceled.
+QVector<triC> kMeansColors(const QImage& image, int numColors,
+                           const QVector<triC>& seedColors,
+                           const QVector<triC>& startCentroids,
+                           const colorTransformerPtr& transformer,
+                           QVector<triC>* centroids);
+
+#endif
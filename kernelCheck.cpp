@@ -0,0 +1,417 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "kernelCheck.h"
+
+#include <algorithm>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QTextStream>
+
+#include <QtGui/QImage>
+
+#include "imageProcessing.h"
+#include "imageUtility.h"
+#include "colorLists.h"
+#include "grid.h"
+#include "triC.h"
+#include "utility.h"
+
+extern const char KERNEL_CHECK_DEFAULT_FILE[] = "kernelOutputs.cstk";
+
+// the number of randomized inputs the kernels are run on
+const int KERNEL_CHECK_CASES = 16;
+// the largest number of squares along an image edge
+const int KERNEL_CHECK_MAX_SQUARES = 24;
+// identifies (and versions) a kernel outputs file
+const quint32 KERNEL_CHECK_MAGIC = 0x6373746b; // "cstk"
+const quint32 KERNEL_CHECK_VERSION = 1;
+
+// the output of one kernel run: an image and/or a list of values (colors,
+// coordinates or counts)
+class kernelOutput {
+
+ public:
+  kernelOutput() {}
+  kernelOutput(const QString& name, const QImage& image,
+               const QVector<quint32>& values = QVector<quint32>())
+    : name_(name), image_(image), values_(values) {}
+  kernelOutput(const QString& name, const QVector<quint32>& values)
+    : name_(name), values_(values) {}
+  QString name() const { return name_; }
+  // return a description of the first difference between this expected
+  // output and <actual>, or an empty string if they're the same
+  QString difference(const kernelOutput& actual) const;
+
+  friend QDataStream& operator<<(QDataStream& out,
+                                 const kernelOutput& output);
+  friend QDataStream& operator>>(QDataStream& in, kernelOutput& output);
+
+ private:
+  QString name_;
+  QImage image_;
+  QVector<quint32> values_;
+};
+
+QString kernelOutput::difference(const kernelOutput& actual) const {
+
+  const QImage& expected = image_;
+  const QImage& got = actual.image_;
+  if (expected.size() != got.size()) {
+    return QString("image size %1x%2, expected %3x%4").
+      arg(got.width()).arg(got.height()).
+      arg(expected.width()).arg(expected.height());
+  }
+  for (int j = 0; j < expected.height(); ++j) {
+    for (int i = 0; i < expected.width(); ++i) {
+      const QRgb expectedPixel = expected.pixel(i, j);
+      const QRgb gotPixel = got.pixel(i, j);
+      if (expectedPixel != gotPixel) {
+        return QString("first differing pixel (%1, %2): %3, expected %4").
+          arg(i).arg(j).arg(::ctos(gotPixel)).arg(::ctos(expectedPixel));
+      }
+    }
+  }
+  const QVector<quint32>& gotValues = actual.values_;
+  for (int i = 0, size = qMin(values_.size(), gotValues.size());
+       i < size; ++i) {
+    if (values_[i] != gotValues[i]) {
+      return QString("first differing value %1: %2, expected %3").
+        arg(i).arg(gotValues[i]).arg(values_[i]);
+    }
+  }
+  if (values_.size() != gotValues.size()) {
+    return QString("%1 values, expected %2").
+      arg(gotValues.size()).arg(values_.size());
+  }
+  return QString();
+}
+
+QDataStream& operator<<(QDataStream& out, const kernelOutput& output) {
+
+  out << output.name_ << output.image_ << output.values_;
+  return out;
+}
+
+QDataStream& operator>>(QDataStream& in, kernelOutput& output) {
+
+  in >> output.name_ >> output.image_ >> output.values_;
+  return in;
+}
+
+// a small deterministic random number generator, so that a given case
+// gets the same input everywhere
+class kernelCheckRandom {
+
+ public:
+  explicit kernelCheckRandom(quint32 seed) : state_(seed * 2654435761u + 1) {}
+  // return a number in [0, n)
+  int next(int n) {
+    state_ = state_ * 1103515245 + 12345;
+    return static_cast<int>((state_ >> 8) % static_cast<quint32>(n));
+  }
+  QRgb nextColor() { return qRgb(next(256), next(256), next(256)); }
+
+ private:
+  quint32 state_;
+};
+
+static QVector<quint32> colorValues(const QVector<triC>& colors) {
+
+  QVector<quint32> values;
+  values.reserve(colors.size());
+  for (int i = 0, size = colors.size(); i < size; ++i) {
+    values.push_back(colors[i].qrgb());
+  }
+  return values;
+}
+
+static QVector<quint32> coordinateValues(const QVector<pairOfInts>& points) {
+
+  QVector<quint32> values;
+  values.reserve(2 * points.size());
+  for (int i = 0, size = points.size(); i < size; ++i) {
+    values.push_back(points[i].x());
+    values.push_back(points[i].y());
+  }
+  return values;
+}
+
+// return a random image made of <xSquares>x<ySquares> squares of
+// <dimension>: runs of colors from a small random palette, with some noisy
+// pixels, so that there are both repeated colors and near ties
+static QImage randomImage(kernelCheckRandom* random, int xSquares,
+                          int ySquares, int dimension) {
+
+  QVector<QRgb> palette;
+  for (int i = 0, count = 2 + random->next(30); i < count; ++i) {
+    palette.push_back(random->nextColor());
+  }
+  QImage image(xSquares * dimension, ySquares * dimension,
+               QImage::Format_RGB32);
+  QRgb color = palette[0];
+  for (int j = 0; j < image.height(); ++j) {
+    for (int i = 0; i < image.width(); ++i) {
+      if (random->next(8) == 0) {
+        color = palette[random->next(palette.size())];
+      }
+      image.setPixel(i, j, random->next(10) == 0 ? random->nextColor() :
+                     color);
+    }
+  }
+  return image;
+}
+
+// run every kernel on case <caseIndex> and return the outputs
+static QList<kernelOutput> kernelOutputs(int caseIndex) {
+
+  kernelCheckRandom random(caseIndex);
+  const int dimension = 1 + random.next(8);
+  const int xSquares = 1 + random.next(KERNEL_CHECK_MAX_SQUARES);
+  const int ySquares = 1 + random.next(KERNEL_CHECK_MAX_SQUARES);
+  const QImage image = randomImage(&random, xSquares, ySquares, dimension);
+  QVector<triC> palette;
+  for (int i = 0, count = 1 + random.next(24); i < count; ++i) {
+    palette.push_back(random.nextColor());
+  }
+  // a random subset of the squares, in random order
+  QList<pixel> squaresList;
+  for (int y = 0; y < ySquares; ++y) {
+    for (int x = 0; x < xSquares; ++x) {
+      if (random.next(3) == 0) {
+        squaresList.insert(random.next(squaresList.size() + 1),
+                           pixel(pairOfInts(x, y)));
+      }
+    }
+  }
+  if (squaresList.isEmpty()) {
+    squaresList.push_back(pixel(pairOfInts(0, 0)));
+  }
+  const int numColors = 1 + random.next(40);
+  const QString prefix = QString("case %1 ").arg(caseIndex);
+  const colorTransformerPtr transformer =
+    colorTransformer::createColorTransformer(caseIndex % 2 ? flossDMC :
+                                             flossVariable);
+  QList<kernelOutput> outputs;
+
+  const int numImageColors = ::numberOfColors(image);
+  outputs.push_back(kernelOutput(prefix + "numberOfColors",
+                                 QVector<quint32>(1, numImageColors)));
+
+  const QVector<triC> chosenColors =
+    ::chooseColors(image, numColors, palette.mid(0, 2), numImageColors,
+                   transformer);
+  outputs.push_back(kernelOutput(prefix + "chooseColors",
+                                 colorValues(chosenColors)));
+  outputs.push_back(kernelOutput(prefix + "chooseColors squares",
+                                 colorValues(::chooseColors(image,
+                                                            squaresList,
+                                                            dimension,
+                                                            numColors,
+                                                            transformer))));
+  QHash<QRgb, int> colorCounts;
+  for (int j = 0; j < image.height(); ++j) {
+    for (int i = 0; i < image.width(); ++i) {
+      ++colorCounts[image.pixel(i, j)];
+    }
+  }
+  QVector<QRgb> seedColors;
+  seedColors.push_back(palette[0].qrgb());
+  outputs.push_back(kernelOutput(prefix + "chooseColorsFromList",
+                                 colorValues(::chooseColorsFromList
+                                             (colorCounts, seedColors,
+                                              numColors, transformer))));
+  outputs.push_back(kernelOutput(prefix + "rgbToDmc",
+                                 colorValues(::rgbToDmc(palette,
+                                                        caseIndex % 3 == 0))));
+
+  QImage segmented = image.copy();
+  const QVector<triC> segmentColors =
+    ::segment(&segmented, palette, numImageColors);
+  outputs.push_back(kernelOutput(prefix + "segment", segmented,
+                                 colorValues(segmentColors)));
+  QImage squaresSegmented = image.copy();
+  ::segment(image, &squaresSegmented, squaresList, dimension, palette);
+  outputs.push_back(kernelOutput(prefix + "segment squares",
+                                 squaresSegmented));
+
+  QImage moded = segmented.copy();
+  const QVector<triC> modeColors = ::mode(&moded, dimension);
+  outputs.push_back(kernelOutput(prefix + "mode", moded,
+                                 colorValues(modeColors)));
+
+  grid medianGrid(segmented);
+  const QVector<triC> medianColors =
+    ::median(&medianGrid, grid(image), dimension);
+  outputs.push_back(kernelOutput(prefix + "median grid",
+                                 medianGrid.toImage(),
+                                 colorValues(medianColors)));
+
+  QVector<historyPixel> oldColors;
+  for (int i = 0, size = squaresList.size(); i < size; ++i) {
+    const pixel& square = squaresList[i];
+    oldColors.push_back(historyPixel(pixel(moded.pixel(square.x() * dimension,
+                                                       square.y() * dimension),
+                                           square.coordinates())));
+  }
+  QImage squaresMedian = segmented.copy();
+  const QVector<triC> squaresMedianColors =
+    ::median(&squaresMedian, image, squaresList, oldColors, dimension);
+  outputs.push_back(kernelOutput(prefix + "median squares", squaresMedian,
+                                 colorValues(squaresMedianColors)));
+
+  const QRgb oldColor = moded.pixel(0, 0);
+  const QRgb newColor = palette[random.next(palette.size())].qrgb();
+  QImage changed = moded.copy();
+  const QVector<pairOfInts> changedSquares =
+    ::changeColor(&changed, oldColor, newColor, dimension);
+  outputs.push_back(kernelOutput(prefix + "changeColor", changed,
+                                 coordinateValues(changedSquares)));
+
+  QImage filled = moded.copy();
+  QVector<pairOfInts> filledSquares =
+    ::fillRegion(&filled, random.next(filled.width()),
+                 random.next(filled.height()), newColor, dimension);
+  // the order of the filled squares depends on the fill algorithm, only
+  // the set of squares is part of the output
+  std::sort(filledSquares.begin(), filledSquares.end());
+  outputs.push_back(kernelOutput(prefix + "fillRegion", filled,
+                                 coordinateValues(filledSquares)));
+
+  QVector<pixel> blockPixels;
+  for (int i = 0, size = squaresList.size(); i < size; ++i) {
+    blockPixels.push_back(pixel(random.nextColor(),
+                                squaresList[i].coordinates()));
+  }
+  QImage blocks = moded.copy();
+  ::changeBlocks(&blocks, blockPixels, dimension, true);
+  outputs.push_back(kernelOutput(prefix + "changeBlocks", blocks));
+
+  QImage oneBlock = moded.copy();
+  ::changeOneBlock(&oneBlock, random.next(oneBlock.width()),
+                   random.next(oneBlock.height()), newColor, dimension);
+  outputs.push_back(kernelOutput(prefix + "changeOneBlock", oneBlock));
+
+  outputs.push_back(kernelOutput(prefix + "findColors",
+                                 colorValues(::findColors(grid(moded),
+                                                          palette))));
+
+  return outputs;
+}
+
+// a group meter that never shows, so that the kernels' progress meters
+// stay hidden while the checks run them on the gui thread
+// (groupProgressDialog::show() only hides the meter when it's called
+// through a groupProgressDialog, and QProgressDialog shows itself from
+// setValue, so block the visibility change itself)
+class hiddenGroupMeter : public groupProgressDialog {
+
+ public:
+  hiddenGroupMeter() : groupProgressDialog(0) {}
+  void setVisible(bool ) { return; }
+};
+
+// return the outputs of all of the cases
+static QList<kernelOutput> allKernelOutputs() {
+
+  // QHash iteration order depends on a per process seed unless it's fixed,
+  // and some kernels choose colors in hash order
+  qSetGlobalQHashSeed(0);
+  hiddenGroupMeter meter;
+  altMeter::setGroupMeter(&meter);
+  QList<kernelOutput> outputs;
+  for (int i = 0; i < KERNEL_CHECK_CASES; ++i) {
+    outputs << kernelOutputs(i);
+  }
+  altMeter::setGroupMeter(NULL);
+  return outputs;
+}
+
+int recordKernelOutputs(const QString& fileName) {
+
+  QTextStream errors(stderr);
+  QFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly)) {
+    errors << "Kernel output record failed: " << fileName << ": " <<
+      file.errorString() << endl;
+    return 1;
+  }
+  const QList<kernelOutput> outputs = allKernelOutputs();
+  QDataStream out(&file);
+  out.setVersion(QDataStream::Qt_5_0);
+  out << KERNEL_CHECK_MAGIC << KERNEL_CHECK_VERSION << outputs;
+  if (out.status() != QDataStream::Ok) {
+    errors << "Kernel output record failed: " << fileName << endl;
+    return 1;
+  }
+  QTextStream(stdout) << "Recorded " << outputs.size() <<
+    " kernel outputs to " << fileName << endl;
+  return 0;
+}
+
+int checkKernelOutputs(const QString& fileName) {
+
+  QTextStream errors(stderr);
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    errors << "Kernel output check failed: " << fileName << ": " <<
+      file.errorString() << endl << "(record the outputs of a known good "
+      "build with --record-kernels)" << endl;
+    return 1;
+  }
+  QDataStream in(&file);
+  in.setVersion(QDataStream::Qt_5_0);
+  quint32 magic = 0, version = 0;
+  QList<kernelOutput> expectedOutputs;
+  in >> magic >> version;
+  if (magic != KERNEL_CHECK_MAGIC || version != KERNEL_CHECK_VERSION) {
+    errors << "Not a kernel outputs file: " << fileName << endl;
+    return 1;
+  }
+  in >> expectedOutputs;
+  if (in.status() != QDataStream::Ok) {
+    errors << "Kernel outputs file is corrupt: " << fileName << endl;
+    return 1;
+  }
+
+  const QList<kernelOutput> outputs = allKernelOutputs();
+  if (outputs.size() != expectedOutputs.size()) {
+    errors << "Kernel outputs file has " << expectedOutputs.size() <<
+      " outputs, expected " << outputs.size() << endl;
+    return 1;
+  }
+  int differences = 0;
+  for (int i = 0, size = outputs.size(); i < size; ++i) {
+    const QString difference = expectedOutputs[i].difference(outputs[i]);
+    if (!difference.isEmpty()) {
+      errors << outputs[i].name() << ": " << difference << endl;
+      ++differences;
+    }
+  }
+  if (differences) {
+    errors << differences << " of " << outputs.size() <<
+      " kernel outputs differ" << endl;
+    return 1;
+  }
+  QTextStream(stdout) << "All " << outputs.size() <<
+    " kernel outputs match" << endl;
+  return 0;
+}
@@ -0,0 +1,47 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef KERNELCHECK_H
+#define KERNELCHECK_H
+
+class QString;
+
+// Golden output checks for the image processing kernels.  Projects are
+// reconstructed by rerunning the kernels, so a faster kernel has to give
+// exactly the same output as the one it replaces.
+// Both functions run every kernel on the same seeded set of randomized
+// images, palettes and square dimensions:
+// recordKernelOutputs writes the outputs to <fileName> (do this with a
+// known good build), and checkKernelOutputs compares the current outputs
+// to the ones recorded in <fileName>, reporting the first differing pixel
+// or value for each output that differs.
+// The processing used is that of the current project version, which the
+// caller must have set.
+// Both return 0 on success, non-zero on a difference or error.
+// KERNEL_CHECK_DEFAULT_FILE is the recording checked when no file is
+// given: the outputs of the 0.9.8.84 (pre-optimization) kernels, kept in
+// the source directory.  The checks only use kernels that 0.9.8.84 has,
+// so that recording is made by adding this file, kernelCheck.cpp,
+// windowManager::runKernelCheck and the --record-kernels option to a
+// 0.9.8.84 build.
+extern const char KERNEL_CHECK_DEFAULT_FILE[];
+int recordKernelOutputs(const QString& fileName);
+int checkKernelOutputs(const QString& fileName);
+
+#endif
@@ -17,6 +17,9 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //
 
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
+
 #include <QtWidgets/QApplication>
 #include <QTranslator>
 
@@ -24,6 +27,22 @@
 #include "windowManager.h"
 #include "imageUtility.h"
 #include "colorLists.h"
+#include "kernelCheck.h"
+#include "trace.h"
+
+// write out the CSTITCH_TRACE trace (if any) for a command line mode that
+// exits before app.exec(), then return <status>
+static int finishCommandLineRun(int status) {
+
+  if (tracer::on()) {
+    const QString traceFile = tracer::fileName();
+    if (!tracer::stop()) {
+      QTextStream(stderr) << "Couldn't write the timing trace to "
+                          << traceFile << endl;
+    }
+  }
+  return status;
+}
 
 int main(int argc, char *argv[]) {
 
@@ -46,7 +65,54 @@ int main(int argc, char *argv[]) {
   // current git label and the current git revision count
   // (if you change "@GIT-VERSION" you'll need to change the script too)
   winManager.setProgramVersion("0.9.8.84"); // @GIT-VERSION - don't touch this comment
+
+  // "cstitch --benchmark [--output <file>] [<image> ...]" times the image
+  // processing kernels, writes the results as json and exits
+  const QStringList arguments = app.arguments();
+  if (arguments.contains("--benchmark")) {
+    QStringList imageFiles;
+    QString outputFile;
+    for (int i = 1, size = arguments.size(); i < size; ++i) {
+      if (arguments[i] == "--output" && i + 1 < size) {
+        outputFile = arguments[++i];
+      }
+      else if (arguments[i] != "--benchmark") {
+        imageFiles.push_back(arguments[i]);
+      }
+    }
+    return ::finishCommandLineRun(winManager.runBenchmarks(imageFiles,
+                                                         outputFile));
+  }
+
+  // "cstitch --record-kernels <file>" records the processing kernel
+  // outputs for a fixed set of random inputs, and
+  // "cstitch --check-kernels [<file>]" checks the current outputs against
+  // a recording (by default the golden recording, see kernelCheck.h)
+  const int recordIndex = arguments.indexOf("--record-kernels");
+  const int checkIndex = arguments.indexOf("--check-kernels");
+  if (recordIndex != -1 && recordIndex + 1 < arguments.size()) {
+    return ::finishCommandLineRun(
+      winManager.runKernelCheck(arguments[recordIndex + 1], true));
+  }
+  if (checkIndex != -1) {
+    const bool haveFile = checkIndex + 1 < arguments.size() &&
+      !arguments[checkIndex + 1].startsWith("--");
+    return ::finishCommandLineRun(
+      winManager.runKernelCheck(haveFile ? arguments[checkIndex + 1] :
+                                QString(KERNEL_CHECK_DEFAULT_FILE),
+                                false));
+  }
+
   colorChooser colorChooserWindow(&winManager);
+
+  // "cstitch --check-project <file>" opens the project <file>, saves it
+  // to a temporary file and checks that the two files match
+  const int projectIndex = arguments.indexOf("--check-project");
+  if (projectIndex != -1 && projectIndex + 1 < arguments.size()) {
+    return ::finishCommandLineRun(
+      winManager.runProjectCheck(arguments[projectIndex + 1]));
+  }
+
   colorChooserWindow.show();
 
   return app.exec();
@@ -0,0 +1,89 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "memoryUsage.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QStringList>
+
+#include <QtGui/QImage>
+#include <QtGui/QPixmap>
+
+void memoryUsage::add(const QString& part, qint64 bytes) {
+
+  parts_.push_back(qMakePair(part, bytes));
+}
+
+void memoryUsage::append(const QString& prefix, const memoryUsage& usage) {
+
+  for (int i = 0, size = usage.parts_.size(); i < size; ++i) {
+    add(prefix + usage.parts_[i].first, usage.parts_[i].second);
+  }
+}
+
+qint64 memoryUsage::total() const {
+
+  qint64 returnTotal = 0;
+  for (int i = 0, size = parts_.size(); i < size; ++i) {
+    returnTotal += parts_[i].second;
+  }
+  return returnTotal;
+}
+
+QString memoryUsage::toString() const {
+
+  QStringList lines;
+  for (int i = 0, size = parts_.size(); i < size; ++i) {
+    lines.push_back(QCoreApplication::translate("memoryUsage", "%1: %2")
+                    .arg(parts_[i].first)
+                    .arg(bytesString(parts_[i].second)));
+  }
+  if (parts_.size() > 1) {
+    lines.push_back(QCoreApplication::translate("memoryUsage", "Total: %1")
+                    .arg(bytesString(total())));
+  }
+  return lines.join("\n");
+}
+
+qint64 memoryUsage::imageBytes(const QImage& image) {
+
+  return static_cast<qint64>(image.bytesPerLine()) * image.height();
+}
+
+qint64 memoryUsage::pixmapBytes(const QPixmap& pixmap) {
+
+  return static_cast<qint64>(pixmap.width()) * pixmap.height() *
+    pixmap.depth() / 8;
+}
+
+QString memoryUsage::bytesString(qint64 bytes) {
+
+  if (bytes < 1024) {
+    return QCoreApplication::translate("memoryUsage", "%1 bytes")
+      .arg(bytes);
+  }
+  else if (bytes < 1024 * 1024) {
+    return QCoreApplication::translate("memoryUsage", "%1 KB")
+      .arg(bytes/1024.0, 0, 'f', 1);
+  }
+  else {
+    return QCoreApplication::translate("memoryUsage", "%1 MB")
+      .arg(bytes/(1024.0 * 1024.0), 0, 'f', 1);
+  }
+}
@@ -0,0 +1,63 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef MEMORYUSAGE_H
+#define MEMORYUSAGE_H
+
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+
+class QImage;
+class QPixmap;
+
+// memoryUsage is a list of the parts of something (an image container,
+// say) that hold memory, along with the bytes held by each, for
+// reporting to the user.  Byte counts are estimates of the memory held by
+// the data itself (pixels, list entries and so on); per object overhead
+// is only counted where it's a large part of the total (the nodes of a
+// hash with small entries, say).
+class memoryUsage {
+
+ public:
+  memoryUsage() {}
+  // add <part> holding <bytes> bytes
+  void add(const QString& part, qint64 bytes);
+  // add <usage>'s total as a single <part>
+  void add(const QString& part, const memoryUsage& usage) {
+    add(part, usage.total());
+  }
+  // add each of <usage>'s parts, with <prefix> prepended to its name
+  void append(const QString& prefix, const memoryUsage& usage);
+  qint64 total() const;
+  bool isEmpty() const { return parts_.isEmpty(); }
+  // one "<part>: <bytes>" line per part, followed by the total if there's
+  // more than one part
+  QString toString() const;
+  // the bytes held by <image>'s (or <pixmap>'s) pixels
+  static qint64 imageBytes(const QImage& image);
+  static qint64 pixmapBytes(const QPixmap& pixmap);
+  // <bytes> in human readable form ("12.3 MB")
+  static QString bytesString(qint64 bytes);
+
+ private:
+  QList<QPair<QString, qint64> > parts_;
+};
+
+#endif
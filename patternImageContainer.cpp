@@ -20,6 +20,7 @@
 #include "patternImageContainer.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QTimer>
 
 #include <QtWidgets/QMessageBox>
 #include <QMouseEvent>
@@ -31,6 +32,7 @@
 #include "symbolDialog.h"
 #include "patternWindow.h"
 #include "imageUtility.h"
+#include "memoryUsage.h"
 #include "patternDockWidget.h"
 #include "xmlUtility.h"
 
@@ -73,6 +75,61 @@ patternImageContainer::patternImageContainer(const QImage& squareImage,
     viewingSquareImage_(false) {
 
   generateColorSquares();
+  generatePaletteIndices();
+  schedulePrewarm();
+}
+
+void patternImageContainer::generatePaletteIndices() {
+
+  QHash<QRgb, int> colorIndices;
+  colorIndices.reserve(flossColors_.size());
+  for (int i = 0, size = flossColors_.size(); i < size; ++i) {
+    colorIndices.insert(flossColors_[i].qrgb(), i);
+  }
+  const int xBoxes = squareImage_.width()/squareDimension_;
+  const int yBoxes = squareImage_.height()/squareDimension_;
+  cellPaletteIndices_.resize(xBoxes * yBoxes);
+  int* indices = cellPaletteIndices_.data();
+  for (int j = 0; j < yBoxes; ++j) {
+    for (int i = 0; i < xBoxes; ++i) {
+      *indices++ =
+        colorIndices.value(squareImage_.pixel(i * squareDimension_,
+                                              j * squareDimension_), -1);
+    }
+  }
+}
+
+void patternImageContainer::schedulePrewarm() {
+
+  // the zoom buttons change the symbol size by 2
+  const int zoomDelta = 2;
+  const bool wasIdle = prewarmSizes_.isEmpty();
+  prewarmSizes_.clear();
+  if (symbolDimension_ + zoomDelta <= MAX_SYMBOL_SIZE) {
+    prewarmSizes_.push_back(symbolDimension_ + zoomDelta);
+  }
+  if (symbolDimension_ - zoomDelta >= MIN_SYMBOL_SIZE) {
+    prewarmSizes_.push_back(symbolDimension_ - zoomDelta);
+  }
+  if (wasIdle && !prewarmSizes_.isEmpty()) {
+    QTimer::singleShot(0, this, SLOT(prewarmSymbolCache()));
+  }
+}
+
+void patternImageContainer::prewarmSymbolCache() {
+
+  if (prewarmSizes_.isEmpty()) {
+    return;
+  }
+  if (symbolChooser_.symbolsPending()) {
+    // don't block on the initial symbols - come back later
+    QTimer::singleShot(50, this, SLOT(prewarmSymbolCache()));
+    return;
+  }
+  symbolChooser_.cacheSymbols(prewarmSizes_.takeFirst());
+  if (!prewarmSizes_.isEmpty()) {
+    QTimer::singleShot(0, this, SLOT(prewarmSymbolCache()));
+  }
 }
 
 void patternImageContainer::generateColorSquares() {
@@ -168,6 +225,7 @@ void patternImageContainer::setSymbolDimension(int dimension) {
   symbolDimension_ = dimension;
   symbolChooser_.setSymbolDimension(dimension);
   generateColorSquares();
+  schedulePrewarm();
 }
 
 QPixmap patternImageContainer::symbolNoBorder(const triC& color,
@@ -186,6 +244,20 @@ QHash<QRgb, QPixmap> patternImageContainer::symbolsWithBorder(int symbolDim, int
   return symbolChooser_.getSymbolsWithBorder(symbolDim, colorBorderWidth);
 }
 
+QVector<QPixmap>
+patternImageContainer::paletteSymbolsWithBorder(int symbolDim,
+                                                int colorBorderWidth) {
+
+  const QHash<QRgb, QPixmap> symbols =
+    symbolChooser_.getSymbolsWithBorder(symbolDim, colorBorderWidth);
+  QVector<QPixmap> returnSymbols;
+  returnSymbols.reserve(flossColors_.size());
+  for (int i = 0, size = flossColors_.size(); i < size; ++i) {
+    returnSymbols.push_back(symbols.value(flossColors_[i].qrgb()));
+  }
+  return returnSymbols;
+}
+
 bool patternImageContainer::updatePatternImage(const triC& color,
                                                int symbolIndex) {
 
@@ -290,6 +362,23 @@ void patternImageContainer::updateHistory(const QDomElement& xmlHistory) {
   }
 }
 
+memoryUsage patternImageContainer::memory() const {
+
+  memoryUsage usage;
+  usage.add(tr("Square image"), memoryUsage::imageBytes(squareImage_));
+  qint64 squareBytes = 0;
+  for (QHash<QRgb, QPixmap>::const_iterator it = colorSquares_.begin(),
+         end = colorSquares_.end(); it != end; ++it) {
+    squareBytes += memoryUsage::pixmapBytes(it.value());
+  }
+  usage.add(tr("Color squares"), squareBytes);
+  usage.add(tr("Symbols"), symbolChooser_.symbolBytes());
+  usage.add(tr("Palette indices"), cellPaletteIndices_.size() * sizeof(int));
+  usage.add(tr("History"), (backHistory_.size() + forwardHistory_.size()) *
+            sizeof(historyIndex));
+  return usage;
+}
+
 QVector<triC> patternImageContainer::colors() const {
 
   QVector<triC> returnColors;
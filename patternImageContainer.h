@@ -27,6 +27,7 @@
 #include "symbolChooser.h"
 
 class patternWindow;
+class memoryUsage;
 class QDomDocument;
 class QDomElement;
 class QMouseEvent;
@@ -64,7 +65,10 @@ class historyIndex {
 // and color squares is determined by symbolDimension_.  Each time
 // symbols of a different size are requested symbolChooser_ must recreate
 // them all at the new size (we don't like scaling things that are to
-// be read).
+// be read).  Recreated symbols come out of symbolChooser's shared symbol
+// cache when possible, and after each size change we pre-render the
+// neighboring zoom sizes into that cache during idle time (see
+// prewarmSymbolCache).
 //
 class patternImageContainer : public QObject {
 
@@ -108,6 +112,16 @@ class patternImageContainer : public QObject {
   QHash<QRgb, QPixmap> symbols();
   // return the symbols using the given <symbolDim> and <colorBorderWidth>
   QHash<QRgb, QPixmap> symbolsWithBorder(int symbolDim, int colorBorderWidth);
+  // symbolsWithBorder, but as a list with the symbol for flossColors()[i]
+  // at index i (for use with paletteIndex)
+  QVector<QPixmap> paletteSymbolsWithBorder(int symbolDim,
+                                            int colorBorderWidth);
+  // return the flossColors() index of the color of the square with box
+  // coordinates (<xBox>, <yBox>), or -1 if it isn't on the list
+  int paletteIndex(int xBox, int yBox) const {
+    return cellPaletteIndices_[yBox * (squareImage_.width()/squareDimension_)
+                               + xBox];
+  }
   QHash<QRgb, QPixmap> colorSquares() const { return colorSquares_; }
   // pop up a symbol change dialog for the user to change the symbol for
   // <color>.
@@ -133,12 +147,25 @@ class patternImageContainer : public QObject {
   void appendHistoryList(const QList<historyIndex>& list,
                          QDomDocument* doc, QDomElement* appendee) const;
   void updateHistory(const QDomElement& xmlHistory);
+  // return the memory held by the square image, the symbols and the
+  // history
+  memoryUsage memory() const;
 
  private:
   void addToHistory(const historyIndex& historyRecord);
   // rewrite colorSquares_ using symbolDimension_ for the square size
   void generateColorSquares();
+  // compute cellPaletteIndices_ from squareImage_ and flossColors_
+  void generatePaletteIndices();
   QVector<triC> colors() const;
+  // queue the sizes adjacent to the current symbol size for caching and
+  // schedule prewarmSymbolCache
+  void schedulePrewarm();
+
+ private slots:
+  // render the symbols for one queued size into the symbol cache, and
+  // reschedule ourself if there are more sizes queued
+  void prewarmSymbolCache();
 
  signals:
   // let users know that the symbol for <color> is now <symbol>
@@ -157,6 +184,10 @@ class patternImageContainer : public QObject {
   // handles construction and choice of symbols
   symbolChooser symbolChooser_;
   QHash<QRgb, QPixmap> colorSquares_;
+  // the flossColors_ index of each square's color, row by row
+  QVector<int> cellPaletteIndices_;
+  // symbol sizes waiting to be rendered into the symbol cache
+  QList<int> prewarmSizes_;
   bool viewingSquareImage_; // is the image on screen the square image?
   // the most recent edit sits on the back of backHistory_
   QList<historyIndex> backHistory_;
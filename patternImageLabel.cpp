@@ -26,7 +26,12 @@
 void patternImageLabel::paintEvent(QPaintEvent* event) {
 
   // we only draw the portion of the image in the viewing rectangle
-  const QRect viewRect = event->rect();
+  // (the widget can be larger than the image, so stop at the image edge)
+  const QRect viewRect =
+    event->rect().intersected(QRect(0, 0, width_, height_));
+  if (viewRect.isEmpty() || patternDim_ <= 0) {
+    return;
+  }
   const int xBoxStart = viewRect.x()/patternDim_;
   const int xStart = xBoxStart * patternDim_;
   const int xEnd = viewRect.x() + viewRect.width();
@@ -46,13 +51,17 @@ void patternImageLabel::paintEvent(QPaintEvent* event) {
     }
   }
   if (gridOn_) {
-    painter.setPen(QColor(gridColor_));
+    QVector<QLine> gridLines;
+    gridLines.reserve((xEnd - xStart)/patternDim_ +
+                      (yEnd - yStart)/patternDim_ + 2);
     for (int i = xStart; i < xEnd; i += patternDim_) {
-      painter.drawLine(QPoint(i, yStart), QPoint(i, yEnd));
+      gridLines.push_back(QLine(i, yStart, i, yEnd));
     }
     for (int j = yStart; j < yEnd; j += patternDim_) {
-      painter.drawLine(QPoint(xStart, j), QPoint(xEnd, j));
+      gridLines.push_back(QLine(xStart, j, xEnd, j));
     }
+    painter.setPen(QColor(gridColor_));
+    painter.drawLines(gridLines);
   }
 }
 
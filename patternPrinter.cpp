@@ -33,6 +33,7 @@
 #include "imageUtility.h"
 #include "colorLists.h"
 #include "utility.h"
+#include "trace.h"
 
 // coordinates for progress meters (meters aren't parented, so we fix
 // constant coords instead of letting the system choose them randomly)
@@ -89,6 +90,8 @@ void patternPrinter::save() {
 
   printer_.setOutputFileName(outputFile);
 
+  // (the dialogs above aren't worth tracing)
+  const traceSpan span("patternPrinter::save");
   // to "print", you draw on the printer object
   // do printer.newPage() for each new page
   if (!beginPainter(outputFile)) {
@@ -97,6 +100,7 @@ void patternPrinter::save() {
   fontMetrics_ = painter_.fontMetrics();
 
   //// draw title pages with the original and squared images
+  traceSpan step("patternPrinter: title page");
   drawTitlePage(metadata);
 
   symbolIconSize_ = metadata.pdfSymbolIconSize();
@@ -117,12 +121,14 @@ void patternPrinter::save() {
   computeOrientationAndPageCounts();
 
   //// present the page-number to image-portion correspondence
+  step.restart("patternPrinter: legend and color list");
   const int legendHeight = drawLegend();
   
   //// present the color list
   drawColorList(legendHeight);
 
   //// draw the pattern pages
+  step.restart("patternPrinter: pattern pages");
   const bool cancel = drawPatternPages();
   if (cancel) {
     // abort probably does nothing; the printer writes to disk as it goes,
@@ -134,7 +140,9 @@ void patternPrinter::save() {
     return;
   }
   // End printing.
+  step.restart("patternPrinter: finish pdf");
   painter_.end();
+  step.restart("patternPrinter: viewer");
 
   maybeLoadExternalPdfViewer(outputFile);
 }
@@ -685,8 +693,10 @@ bool patternPrinter::drawPatternPages() {
   int widthToUse = widthPerPage_;
   int heightToUse = heightPerPage_;
   const int f = 5; // fudge room for grid number separation from the grid
-  const QHash<QRgb, QPixmap> symbolMap =
-    imageContainer_->symbolsWithBorder(symbolSize_, symbolColorBorderWidth_);
+  // symbols by palette index, so that each square is an array lookup
+  const QVector<QPixmap> paletteSymbols =
+    imageContainer_->paletteSymbolsWithBorder(symbolSize_,
+                                              symbolColorBorderWidth_);
   QProgressDialog progressMeter(QObject::tr("Creating pdf..."),
                                 QObject::tr("Cancel"), 0,
                                 (xPages_ * yPages_)/5);
@@ -694,6 +704,9 @@ bool patternPrinter::drawPatternPages() {
   progressMeter.setWindowModality(Qt::WindowModal);
   progressMeter.move(PROGRESS_X_COORDINATE, PROGRESS_Y_COORDINATE);
   progressMeter.show();
+  // this page's grid lines (reused between pages)
+  QVector<QLine> thinLines;
+  QVector<QLine> boldLines;
   for (int x = 1; x <= xPages_; ++x) {
     for (int y = 1; y <= yPages_; ++y) {
       if (progressMeter.wasCanceled()) {
@@ -724,32 +737,38 @@ bool patternPrinter::drawPatternPages() {
             ++j, ++jj) {
         for (int i = patternXBoxStart, ii = 0; i < patternXBoxEnd;
               ++i, ++ii) {
-          const QPixmap& thisSymbol =
-            symbolMap[squareImage_.pixel(i * squareDim_, j * squareDim_)];
-          painter_.drawPixmap(margin_ + ii * symbolSize_,
-                              margin_ + jj * symbolSize_, thisSymbol);
+          const int paletteIndex = imageContainer_->paletteIndex(i, j);
+          if (paletteIndex != -1) {
+            painter_.drawPixmap(margin_ + ii * symbolSize_,
+                                margin_ + jj * symbolSize_,
+                                paletteSymbols[paletteIndex]);
+          }
         }
       }
 
       //// draw grid lines and counts
-      //// x grid lines
-      painter_.setPen(QPen(Qt::black, 1));
+      // Lines are collected and then drawn with one drawLines call per pen
+      // (thin and bold) so that we don't switch pens for every line.
+      thinLines.clear();
+      boldLines.clear();
+      //// the thin x grid lines
       int tx = 0;
-      //// draw the thin x grid lines
       while (tx * symbolSize_ <= widthToUse) {
-        painter_.drawLine(tx * symbolSize_ + margin_, margin_,
-                          tx * symbolSize_ + margin_, heightToUse + margin_);
+        thinLines.push_back(QLine(tx * symbolSize_ + margin_, margin_,
+                                  tx * symbolSize_ + margin_,
+                                  heightToUse + margin_));
         ++tx;
       }
       bool lastXLine = false;
       if ((x-1) * widthPerPage_ + tx * symbolSize_ > patternImageWidth_) {
         lastXLine = true; // the last x line is drawn on this page
       }
-      //// draw the thin y grid lines
+      //// the thin y grid lines
       int ty = 0;
       while (ty * symbolSize_ <= heightToUse) {
-        painter_.drawLine(margin_, ty * symbolSize_ + margin_,
-                          widthToUse + margin_, ty * symbolSize_ + margin_);
+        thinLines.push_back(QLine(margin_, ty * symbolSize_ + margin_,
+                                  widthToUse + margin_,
+                                  ty * symbolSize_ + margin_));
         ++ty;
       }
       bool lastYLine = false;
@@ -765,9 +784,7 @@ bool patternPrinter::drawPatternPages() {
         tx = boldLinesFrequency_ - ((x-1) * xBoxesPerPage_ % boldLinesFrequency_);
       }
 
-      const int savedTx = tx;
-      // draw the x grid counts
-      painter_.setPen(QPen(Qt::black, 1));
+      // the x grid counts and bold x grid lines
       while (tx * symbolSize_ <= widthToUse) {
         const int tgridx = (x-1) * xBoxesPerPage_ + tx;
         if (tx == 0) { // avoid collision
@@ -778,27 +795,19 @@ bool patternPrinter::drawPatternPages() {
           painter_.drawText(margin_ + tx * symbolSize_ - sWidth(tgridx),
                             margin_ - f, ::itoqs(tgridx));
         }
+        boldLines.push_back(QLine(tx * symbolSize_ + margin_, margin_,
+                                  tx * symbolSize_ + margin_,
+                                  heightToUse + margin_));
         tx += boldLinesFrequency_;
       }
 
-      // draw the bold x grid lines
-      tx = savedTx;
-      painter_.setPen(QPen(Qt::black, 3));
-      while (tx * symbolSize_ <= widthToUse) {
-        painter_.drawLine(tx * symbolSize_ + margin_, margin_,
-                          tx * symbolSize_ + margin_, heightToUse + margin_);
-        tx += boldLinesFrequency_;
-      }
-      tx -= boldLinesFrequency_;
-
-      // draw the final line
+      // the final line
       if (lastXLine) {
-        painter_.setPen(QPen(Qt::black, 1));
         painter_.drawText(margin_ + widthToUse - sWidth(xBoxes_), margin_ - f,
                           ::itoqs(xBoxes_));
-        painter_.setPen(QPen(Qt::black, 3));
-        painter_.drawLine(widthToUse + margin_, margin_, widthToUse + margin_,
-                          heightToUse + margin_);
+        boldLines.push_back(QLine(widthToUse + margin_, margin_,
+                                  widthToUse + margin_,
+                                  heightToUse + margin_));
       }
 
       ty = 0; // y grid count for this page
@@ -807,9 +816,7 @@ bool patternPrinter::drawPatternPages() {
         ty = boldLinesFrequency_ - ((y-1) * yBoxesPerPage_ % boldLinesFrequency_);
       }
 
-      const int savedTy = ty;
-      // draw the y grid counts
-      painter_.setPen(QPen(Qt::black, 1));
+      // the y grid counts and bold y grid lines
       while (ty * symbolSize_ <= heightToUse) {
         const int tgridy = (y-1) * yBoxesPerPage_ + ty;
         if (ty == 0) { // avoid confusion
@@ -822,28 +829,24 @@ bool patternPrinter::drawPatternPages() {
                             ty * symbolSize_ + margin_,
                             ::itoqs(tgridy));
         }
+        boldLines.push_back(QLine(margin_, ty * symbolSize_ + margin_,
+                                  widthToUse + margin_,
+                                  ty * symbolSize_ + margin_));
         ty += boldLinesFrequency_;
       }
 
-      // draw the bold y grid lines
-      ty = savedTy;
-      painter_.setPen(QPen(Qt::black, 3));
-      while (ty * symbolSize_ <= heightToUse) {
-        painter_.drawLine(margin_, ty * symbolSize_ + margin_,
-                          widthToUse + margin_, ty * symbolSize_ + margin_);
-        ty += boldLinesFrequency_;
-      }
-
-      // draw the final line
+      // the final line
       if (lastYLine) {
-        painter_.setPen(QPen(Qt::black, 1));
         painter_.drawText(margin_ - sWidth(yBoxes_) - f, heightToUse + margin_,
                           ::itoqs(yBoxes_));
-        painter_.setPen(QPen(Qt::black, 3));
-        painter_.drawLine(margin_, heightToUse + margin_, widthToUse + margin_,
-                          heightToUse + margin_);
+        boldLines.push_back(QLine(margin_, heightToUse + margin_,
+                                  widthToUse + margin_,
+                                  heightToUse + margin_));
       }
 
+      painter_.drawLines(thinLines); // (pen is thin here)
+      painter_.setPen(QPen(Qt::black, 3));
+      painter_.drawLines(boldLines);
       painter_.setPen(QPen(Qt::black, 1)); // reset
 
       if (x < xPages_ || y < yPages_) {
@@ -46,6 +46,7 @@
 #include "dockImage.h"
 #include "xmlUtility.h"
 #include "floss.h"
+#include "memoryUsage.h"
 
 // bounds for allowed symbol sizes (too large and file sizes are ridiculous,
 // too small and symbols can't be distinguished)
@@ -70,7 +71,7 @@ patternWindow::patternWindow(windowManager* winMgr)
 
   dockImageHolder_ = new QDockWidget(this);
   dockImageHolder_->setFeatures(QDockWidget::NoDockWidgetFeatures);
-  dockImage_ = new dockImage(winManager()->originalImage(), this);
+  dockImage_ = new dockImage(winManager()->originalPyramid(), this);
   dockImageHolder_->setWidget(dockImage_);
   addDockWidget(Qt::RightDockWidgetArea, dockImageHolder_);
   connect(scroll_->horizontalScrollBar(), SIGNAL(valueChanged(int )),
@@ -498,17 +499,24 @@ void patternWindow::displayImageInfo() {
                              .arg(::itoqs(height))
                              .arg(::itoqs(symbolDim))
                              .arg(::itoqs(xBoxes))
-                             .arg(::itoqs(yBoxes)));
+                             .arg(::itoqs(yBoxes)) +
+                             imageInfoMemoryString(curImage_->memory()));
   }
 }
 
-void patternWindow::writeCurrentHistory(QDomDocument* doc,
-                                        QDomElement* appendee,
+void patternWindow::writeCurrentHistory(xmlWriter* writer,
                                         int imageIndex) {
 
   patternImagePtr container = getImageFromIndex(imageIndex);
   if (container) {
-    container->writeSymbolHistory(doc, appendee);
+    // symbol histories are small, so build them as dom and copy them over
+    QDomDocument doc;
+    QDomElement history(doc.createElement("history"));
+    container->writeSymbolHistory(&doc, &history);
+    for (QDomElement child = history.firstChildElement(); !child.isNull();
+         child = child.nextSiblingElement()) {
+      ::writeDomElement(writer, child);
+    }
   }
   else {
     qWarning() << "Misplaced container in patternWriteHistory" << 
@@ -530,13 +538,12 @@ patternImagePtr patternWindow::getImageFromIndex(int index) const {
   }
 }
 
-void patternWindow::updateHistory(const QDomElement& xml) {
+void patternWindow::updateHistory(int imageIndex,
+                                  const QDomElement& symbolHistory) {
 
-  const int imageIndex = ::getElementText(xml, "index").toInt();
-  const QDomElement& xmlHistory = xml.firstChildElement("symbol_history");
   patternImagePtr container = getImageFromIndex(imageIndex);
   if (container) {
-    container->updateHistory(xmlHistory);
+    container->updateHistory(symbolHistory);
     updateImageLabelSymbols();
     updateHistoryButtonStates();
   }
@@ -594,6 +601,22 @@ QString patternWindow::updateCurrentSettings(const QDomElement& xml) {
   return errorMessage;
 }
 
+memoryUsage patternWindow::imagesMemory() const {
+
+  memoryUsage usage;
+  const QList<QAction*> actions = imageListMenu_->actions();
+  for (int i = 0, size = actions.size(); i < size; ++i) {
+    const QAction* thisAction = actions[i];
+    if (!thisAction->data().isNull() &&
+        thisAction->data().canConvert<patternImagePtr>()) {
+      const patternImagePtr thisImage =
+        thisAction->data().value<patternImagePtr>();
+      usage.add(thisImage->name(), thisImage->memory());
+    }
+  }
+  return usage;
+}
+
 void patternWindow::appendCurrentSettings(QDomDocument* doc,
                                           QDomElement* appendee) const {
 
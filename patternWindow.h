@@ -36,6 +36,7 @@ class helpMode;
 template<class T> class findActionName;
 class QDomDocument;
 class QDomElement;
+class xmlWriter;
 class QScrollArea;
 class QPushButton;
 class QVBoxLayout;
@@ -125,18 +126,18 @@ class patternWindow : public imageSaverWindow {
   void addImage(const QImage& squareImage, int squareDimension,
                 const QVector<flossColor>& colors, QRgb gridColor,
                 int imageIndex);
-  // append the current edit history for the image with index <imageIndex>
-  // to appendee
-  void writeCurrentHistory(QDomDocument* doc, QDomElement* appendee,
-                           int imageIndex);
-  // set the history for the image whose information is contained in <xml>
-  // and run the backward history if any
-  void updateHistory(const QDomElement& xml);
+  // write the current edit history for the image with index <imageIndex>
+  // to <writer>
+  void writeCurrentHistory(xmlWriter* writer, int imageIndex);
+  // set the history for the image with index <imageIndex> from its
+  // <symbolHistory> element and run the backward history if any
+  void updateHistory(int imageIndex, const QDomElement& symbolHistory);
   // set the grid to be on/off, with color <color>
   void setGrid(QRgb color, bool gridOn);
   void appendCurrentSettings(QDomDocument* doc,
                              QDomElement* appendee) const; //override;
   QString updateCurrentSettings(const QDomElement& xml); //override;
+  memoryUsage imagesMemory() const; //override;
 
  private:
   // constructor helper
@@ -19,6 +19,11 @@
 
 #include "squareImageContainer.h"
 
+#include <algorithm>
+
+#include <QtCore/QDebug>
+#include <QtCore/QSettings>
+
 #include <QtGui/QPainter>
 
 #include "colorLists.h"
@@ -29,6 +34,27 @@
 #include "symbolChooser.h"
 #include "versionProcessing.h"
 
+// the number of history items between history checkpoints (before any
+// thinning)
+const int HISTORY_CHECKPOINT_INTERVAL = 32;
+// the default memory limit for each image's history checkpoints, in
+// megabytes; can be overridden by the "history_checkpoint_memory"
+// setting
+const int HISTORY_CHECKPOINT_MEGABYTES = 32;
+
+// a color's cell list is compacted once it holds more than twice its
+// number of squares plus this many cells
+const int COLOR_CELL_COMPACT_SLACK = 64;
+
+static int historyCheckpointByteLimit() {
+
+  const QSettings settings("cstitch", "cstitch");
+  const int megabytes =
+    settings.value("history_checkpoint_memory",
+                   HISTORY_CHECKPOINT_MEGABYTES).toInt();
+  return qMax(0, megabytes) * 1024 * 1024;
+}
+
 mutableSquareImageContainer::mutableSquareImageContainer(const QString& name,
                                            const QVector<triC>& colors,
                                            const QImage& image,
@@ -37,29 +63,234 @@ mutableSquareImageContainer::mutableSquareImageContainer(const QString& name,
     toolFlossType_(flossVariable), originalDimension_(dimension),
     widthSquareCount_(image.width()/dimension),
     heightSquareCount_(image.height()/dimension),
-    colorListCheckNeeded_(false) {
+    checkpointInterval_(HISTORY_CHECKPOINT_INTERVAL), checkpointBytes_(0),
+    checkpointByteLimit_(historyCheckpointByteLimit()),
+    colorListCheckNeeded_(false), historyReadFailed_(false) {
 
   if ((!colors.empty()) &&
      colors.size() <= symbolChooser::maxNumberOfSymbols()) {
     valid_ = true;
     invalidColorCount_ = 0;
+    flossColors_.reserve(colors.size());
     for (int i = 0, size = colors.size(); i < size; ++i) {
       flossColors_.push_back(flossColor(colors[i], type));
     }
+    reindexColors();
   }
   else {
     valid_ = false;
     invalidColorCount_ = colors.size();
     flossColors_ = QVector<flossColor>();
   }
+  indexColorCells();
+  addCheckpoint();
   squareImageContainer::setScaledSize(QSize(0, 0));
 }
 
+void colorCellList::add(int cell) {
+
+  if (compact_ && !cells_.isEmpty() && cell <= cells_.last()) {
+    compact_ = false;
+  }
+  cells_.push_back(cell);
+  ++count_;
+}
+
+void colorCellList::remove(int cell) {
+
+  --count_;
+  // (the last cell can go right away without spoiling the order)
+  if (compact_ && !cells_.isEmpty() && cells_.last() == cell) {
+    cells_.pop_back();
+  }
+  else {
+    compact_ = false;
+  }
+}
+
+void colorCellList::append(const colorCellList& other) {
+
+  if (other.cells_.isEmpty()) {
+    return;
+  }
+  compact_ = compact_ && other.compact_ &&
+    (cells_.isEmpty() || other.cells_.first() > cells_.last());
+  cells_ += other.cells_;
+  count_ += other.count_;
+}
+
+bool colorCellList::needsCompaction() const {
+
+  return cells_.size() > 2*count_ + COLOR_CELL_COMPACT_SLACK;
+}
+
+void colorCellList::compact(const QImage& image, QRgb color, int dimension,
+                            int xSquareCount) {
+
+  if (compact_) {
+    return;
+  }
+  QVector<int> cells;
+  cells.reserve(count_);
+  for (int i = 0, size = cells_.size(); i < size; ++i) {
+    const int cell = cells_[i];
+    if (image.pixel((cell % xSquareCount) * dimension,
+                    (cell / xSquareCount) * dimension) == color) {
+      cells.push_back(cell);
+    }
+  }
+  std::sort(cells.begin(), cells.end());
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+  cells_ = cells;
+  compact_ = true;
+}
+
+void mutableSquareImageContainer::indexColorCells() {
+
+  colorCells_.clear();
+  for (int yBox = 0, cell = 0; yBox < heightSquareCount_; ++yBox) {
+    for (int xBox = 0; xBox < widthSquareCount_; ++xBox, ++cell) {
+      colorCells_[image_.pixel(xBox * originalDimension_,
+                               yBox * originalDimension_)].add(cell);
+    }
+  }
+}
+
+QHash<QRgb, int> mutableSquareImageContainer::colorCounts() const {
+
+  QHash<QRgb, int> counts;
+  counts.reserve(colorCells_.size());
+  for (QHash<QRgb, colorCellList>::const_iterator it = colorCells_.begin(),
+         end = colorCells_.end(); it != end; ++it) {
+    counts.insert(it.key(), it.value().count());
+  }
+  return counts;
+}
+
+void mutableSquareImageContainer::moveCell(int xBox, int yBox,
+                                           QRgb oldColor, QRgb newColor) {
+
+  if (oldColor == newColor) {
+    return;
+  }
+  const int cell = yBox * widthSquareCount_ + xBox;
+  const QHash<QRgb, colorCellList>::iterator oldIt =
+    colorCells_.find(oldColor);
+  if (oldIt != colorCells_.end()) {
+    colorCellList& oldCells = oldIt.value();
+    oldCells.remove(cell);
+    if (oldCells.count() == 0) {
+      colorCells_.erase(oldIt);
+    }
+    else if (oldCells.needsCompaction()) {
+      compactCells(oldColor, &oldCells);
+    }
+  }
+  else {
+    qWarning() << "Missing color cell" << ::ctos(oldColor) << xBox << yBox;
+  }
+  colorCellList& newCells = colorCells_[newColor];
+  newCells.add(cell);
+  if (newCells.needsCompaction()) {
+    compactCells(newColor, &newCells);
+  }
+}
+
+void mutableSquareImageContainer::
+moveCells(const QVector<pairOfInts>& boxCoordinates, QRgb oldColor,
+          QRgb newColor) {
+
+  for (int i = 0, size = boxCoordinates.size(); i < size; ++i) {
+    moveCell(boxCoordinates[i].x(), boxCoordinates[i].y(),
+             oldColor, newColor);
+  }
+}
+
+QVector<pairOfInts>
+mutableSquareImageContainer::colorSquares(QRgb color) const {
+
+  const QHash<QRgb, colorCellList>::iterator it = colorCells_.find(color);
+  if (it == colorCells_.end()) {
+    return QVector<pairOfInts>();
+  }
+  // (a compact list is in the same order a scan would find the squares
+  // in)
+  compactCells(color, &it.value());
+  const QVector<int>& cells = it.value().cells();
+  QVector<pairOfInts> squares;
+  squares.reserve(cells.size());
+  for (int i = 0, size = cells.size(); i < size; ++i) {
+    squares.push_back(pairOfInts(cells[i] % widthSquareCount_,
+                                 cells[i] / widthSquareCount_));
+  }
+  return squares;
+}
+
+void mutableSquareImageContainer::moveAllCells(QRgb oldColor, QRgb newColor) {
+
+  const QHash<QRgb, colorCellList>::iterator oldIt =
+    colorCells_.find(oldColor);
+  if (oldColor == newColor || oldIt == colorCells_.end()) {
+    return;
+  }
+  const colorCellList oldCells = oldIt.value();
+  colorCells_.erase(oldIt);
+  const QHash<QRgb, colorCellList>::iterator newIt =
+    colorCells_.find(newColor);
+  if (newIt == colorCells_.end()) {
+    colorCells_.insert(newColor, oldCells);
+  }
+  else {
+    newIt.value().append(oldCells);
+    if (newIt.value().needsCompaction()) {
+      compactCells(newColor, &newIt.value());
+    }
+  }
+}
+
+QVector<pairOfInts>
+mutableSquareImageContainer::changeColorCells(QRgb oldColor, QRgb newColor) {
+
+  if (oldColor == newColor) {
+    return QVector<pairOfInts>();
+  }
+  const QVector<pairOfInts> changedSquares = colorSquares(oldColor);
+  ::changeBlocks(&image_, changedSquares, newColor, originalDimension_, true);
+  moveAllCells(oldColor, newColor);
+  return changedSquares;
+}
+
+QList<colorChange> mutableSquareImageContainer::
+remapColors(const QList<QPair<QRgb, QRgb> >& colorMap) {
+
+  QList<colorChange> changes;
+  for (int i = 0, size = colorMap.size(); i < size; ++i) {
+    const QRgb oldColor = colorMap[i].first;
+    const QRgb newColor = colorMap[i].second;
+    if (oldColor != newColor) {
+      const QVector<pairOfInts> squares = colorSquares(oldColor);
+      if (!squares.empty()) {
+        changes.push_back(colorChange(oldColor, newColor, squares));
+      }
+    }
+  }
+  ::applyColorChanges(&image_, changes, originalDimension_);
+  for (int i = 0, size = changes.size(); i < size; ++i) {
+    moveAllCells(changes[i].oldColor(), changes[i].newColor());
+  }
+  return changes;
+}
+
 QVector<triC> mutableSquareImageContainer::checkColorList() {
 
   if (colorListCheckNeeded_) {
-    const grid gridImage(image_);
-    const QVector<triC> colorsToRemove = ::findColors(gridImage, colors());
+    // colors on the list with no squares in the image
+    QVector<triC> colorsToRemove;
+    for (int i = 0, size = flossColors_.size(); i < size; ++i) {
+      if (!colorCells_.contains(flossColors_[i].qrgb())) {
+        colorsToRemove.push_back(flossColors_[i].color());
+      }
+    }
     removeColors(colorsToRemove);
     colorListCheckNeeded_ = false;
     return colorsToRemove;
@@ -69,12 +300,26 @@ QVector<triC> mutableSquareImageContainer::checkColorList() {
   }
 }
 
+void mutableSquareImageContainer::reindexColors(int startIndex) {
+
+  if (startIndex == 0) {
+    colorIndices_.clear();
+    colorIndices_.reserve(flossColors_.size());
+  }
+  for (int i = startIndex, size = flossColors_.size(); i < size; ++i) {
+    colorIndices_.insert(flossColors_[i].qrgb(), i);
+  }
+}
+
 flossColor mutableSquareImageContainer::removeColor(const triC& color) {
 
-  const int removeIndex = flossColors_.indexOf(flossColor(color));
+  const int removeIndex = paletteIndex(color.qrgb());
   if (removeIndex != -1) {
     const flossColor returnColor = flossColors_[removeIndex];
     flossColors_.remove(removeIndex);
+    colorIndices_.remove(color.qrgb());
+    // colors after the removed one have moved down one
+    reindexColors(removeIndex);
     return returnColor;
   }
   else {
@@ -118,11 +363,13 @@ performDetailing(const QImage& originalImage,
   for (int i = 0, size = history.size(); i < size; ++i) {
     const triC thisColor(newColors[i]);
     history[i].setNewColor(thisColor.qrgb());
+    moveCell(history[i].x(), history[i].y(), history[i].oldColor().qrgb(),
+             thisColor.qrgb());
     const flossColor thisFlossColor(thisColor, type);
-    if (!flossColors_.contains(thisFlossColor)) {
+    if (paletteIndex(thisColor.qrgb()) == -1) {
       history[i].setNewColorIsNew(true);
       colorsToAdd.push_back(thisFlossColor);
-      flossColors_.push_back(thisFlossColor);
+      appendColor(thisFlossColor);
     }
   }
   colorListCheckNeeded_ = true;
@@ -132,11 +379,11 @@ performDetailing(const QImage& originalImage,
 
 bool mutableSquareImageContainer::addColor(const flossColor& color) {
 
-  if (!flossColors_.contains(color)) {
+  if (paletteIndex(color.qrgb()) == -1) {
     const addSquareColorVersionPtr addVersion =
       versionProcessor::processor()->addSquareColor();
     const flossColor versionColor = addVersion->transform(color);
-    flossColors_.push_back(versionColor);
+    appendColor(versionColor);
     return true;
   }
   else {
@@ -168,7 +415,7 @@ mutableSquareImageContainer::changeColor(QRgb oldColor,
     return dockListUpdate();
   }
   const QVector<pairOfInts> changedSquares =
-    ::changeColor(&image_, oldColor, newColor, originalDimension_);
+    changeColorCells(oldColor, newColor);
   if (!changedSquares.empty()) {
     const bool colorAdded = addColor(newFlossColor);
     const flossColor oldFlossColor = removeColor(oldColor);
@@ -192,6 +439,7 @@ dockListUpdate mutableSquareImageContainer::fillRegion(int x, int y,
   }
   const QVector<pairOfInts> coordinates =
     ::fillRegion(&image_, x, y, newColor.qrgb(), originalDimension_);
+  moveCells(coordinates, oldColor.qrgb(), newColor.qrgb());
 
   const bool colorAdded = addColor(newColor);
   const flossColor oldFlossColor = getFlossColorFromColor(oldColor);
@@ -219,6 +467,12 @@ commitChangeOneDrag(const QSet<pairOfInts>& squares, flossColor newColor) {
     historyPixels.push_back(pixel(thisColor, pairOfInts(x, y)));
   }
   ::changeBlocks(&image_, historyPixels, newRgbColor, originalDimension_);
+  for (int i = 0, size = historyPixels.size(); i < size; ++i) {
+    const pixel& thisPixel = historyPixels[i];
+    moveCell(thisPixel.x() / originalDimension_,
+             thisPixel.y() / originalDimension_, thisPixel.color(),
+             newRgbColor);
+  }
   addToHistory(historyItemPtr(new changeOneHistoryItem(newColor, colorAdded,
                                                        historyPixels)));
   colorListCheckNeeded_ = true;
@@ -227,10 +481,17 @@ commitChangeOneDrag(const QSet<pairOfInts>& squares, flossColor newColor) {
 
 dockListUpdate mutableSquareImageContainer::moveHistoryForward() {
 
+  historyReadFailed_ = false;
   if (!forwardHistory_.empty()) {
+    const dockListUpdate update =
+      forwardHistory_.front()->performHistoryEdit(this, H_FORWARD);
+    if (historyReadFailed_) { // nothing changed
+      return update;
+    }
     backHistory_.push_back(forwardHistory_.front());
     forwardHistory_.pop_front();
-    return backHistory_.back()->performHistoryEdit(this, H_FORWARD);
+    addCheckpoint();
+    return update;
   }
   else {
     return dockListUpdate();
@@ -239,11 +500,16 @@ dockListUpdate mutableSquareImageContainer::moveHistoryForward() {
 
 dockListUpdate mutableSquareImageContainer::moveHistoryBack() {
 
+  historyReadFailed_ = false;
   if (!backHistory_.empty()) {
     const dockListUpdate update =
       backHistory_.back()->performHistoryEdit(this, H_BACK);
+    if (historyReadFailed_) { // nothing changed
+      return update;
+    }
     forwardHistory_.push_front(backHistory_.back());
     backHistory_.pop_back();
+    addCheckpoint();
     return update;
   }
   else {
@@ -251,120 +517,230 @@ dockListUpdate mutableSquareImageContainer::moveHistoryBack() {
   }
 }
 
-QDomDocument mutableSquareImageContainer::backImageHistoryXml() const {
+dockListUpdate mutableSquareImageContainer::jumpToHistoryIndex(int index) {
 
-  QDomDocument doc;
-  QDomElement root(doc.createElement("square_history"));
-  doc.appendChild(root);
-  QDomElement history(doc.createElement("backward_history"));
-  root.appendChild(history);
-  history.setAttribute("count", backHistory_.size());
-  for (int i = 0, size = backHistory_.size(); i < size; ++i) {
-    backHistory_[i]->toXml(&doc, &history);
+  index = qBound(0, index, historyCount());
+  const int startIndex = backHistory_.size();
+  if (index == startIndex) {
+    return dockListUpdate();
+  }
+  const QVector<flossColor> startColors = flossColors_;
+
+  // find the checkpoint closest to index, if it's closer than we are
+  int checkpointIndex = -1;
+  int distance = qAbs(index - startIndex);
+  QMap<int, historyCheckpoint>::const_iterator it =
+    checkpoints_.lowerBound(index);
+  if (it != checkpoints_.constEnd() && it.key() - index < distance) {
+    checkpointIndex = it.key();
+    distance = it.key() - index;
+  }
+  if (it != checkpoints_.constBegin()) {
+    --it;
+    if (index - it.key() < distance) {
+      checkpointIndex = it.key();
+    }
   }
-  return doc;
+  if (checkpointIndex != -1) {
+    restoreCheckpoint(checkpointIndex);
+  }
+
+  // (stop short if a history item's data is lost)
+  historyReadFailed_ = false;
+  while (backHistory_.size() < index && !historyReadFailed_) {
+    moveHistoryForward();
+  }
+  while (backHistory_.size() > index && !historyReadFailed_) {
+    moveHistoryBack();
+  }
+
+  // the dock needs the net color list change
+  QSet<QRgb> startRgbs;
+  for (int i = 0, size = startColors.size(); i < size; ++i) {
+    startRgbs.insert(startColors[i].qrgb());
+  }
+  QVector<flossColor> colorsToAdd;
+  for (int i = 0, size = flossColors_.size(); i < size; ++i) {
+    if (!startRgbs.remove(flossColors_[i].qrgb())) {
+      colorsToAdd.push_back(flossColors_[i]);
+    }
+  }
+  QVector<triC> colorsToRemove;
+  for (int i = 0, size = startColors.size(); i < size; ++i) {
+    if (startRgbs.contains(startColors[i].qrgb())) {
+      colorsToRemove.push_back(startColors[i].color());
+    }
+  }
+  return dockListUpdate(colorsToAdd, colorsToRemove);
 }
 
-void mutableSquareImageContainer::
-writeImageHistory(QDomDocument* doc, QDomElement* appendee) const {
+void mutableSquareImageContainer::addCheckpoint() {
+
+  const int position = backHistory_.size();
+  if (position % checkpointInterval_ != 0 ||
+      checkpoints_.contains(position)) {
+    return;
+  }
+  const historyCheckpoint checkpoint(::squareColorImage(image_,
+                                                        originalDimension_),
+                                     flossColors_);
+  checkpoints_.insert(position, checkpoint);
+  checkpointBytes_ += checkpoint.bytes();
+  // thin out the checkpoints until they fit (but always keep the one for
+  // the unedited image)
+  while (checkpointBytes_ > checkpointByteLimit_ && checkpoints_.size() > 1) {
+    checkpointInterval_ *= 2;
+    QMap<int, historyCheckpoint>::iterator it = checkpoints_.begin();
+    while (it != checkpoints_.end()) {
+      if (it.key() != 0 && it.key() % checkpointInterval_ != 0) {
+        checkpointBytes_ -= it.value().bytes();
+        it = checkpoints_.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+  }
+}
 
-  ::appendTextElement(doc, "tool_floss_type", toolFlossType_.prefix(),
-                      appendee);
+void mutableSquareImageContainer::removeCheckpointsAfter(int position) {
 
-  if (backHistory_.empty() && forwardHistory_.empty()) {
+  QMap<int, historyCheckpoint>::iterator it =
+    checkpoints_.upperBound(position);
+  while (it != checkpoints_.end()) {
+    checkpointBytes_ -= it.value().bytes();
+    it = checkpoints_.erase(it);
+  }
+}
+
+void mutableSquareImageContainer::restoreCheckpoint(int position) {
+
+  const QMap<int, historyCheckpoint>::const_iterator it =
+    checkpoints_.constFind(position);
+  if (it == checkpoints_.constEnd()) {
+    qWarning() << "Missing history checkpoint" << position;
     return;
   }
+  ::drawSquareColorImage(&image_, it.value().squareColors(),
+                         originalDimension_);
+  indexColorCells();
+  // the checkpoint's list can hold colors that had already left the image
+  // (they stay until checkColorList), so keep just the colors with
+  // squares; the list then matches the image and needs no check
+  const QVector<flossColor> checkpointColors = it.value().colors();
+  flossColors_.clear();
+  flossColors_.reserve(checkpointColors.size());
+  for (int i = 0, size = checkpointColors.size(); i < size; ++i) {
+    if (colorCells_.contains(checkpointColors[i].qrgb())) {
+      flossColors_.push_back(checkpointColors[i]);
+    }
+  }
+  reindexColors();
+  for (QHash<QRgb, colorCellList>::const_iterator cellIt =
+         colorCells_.constBegin(), end = colorCells_.constEnd();
+       cellIt != end; ++cellIt) {
+    if (paletteIndex(cellIt.key()) == -1) {
+      qWarning() << "Checkpoint color list is missing" <<
+        ::ctos(cellIt.key());
+      appendColor(flossColor(triC(cellIt.key())));
+    }
+  }
+  colorListCheckNeeded_ = false;
+  while (backHistory_.size() > position) {
+    forwardHistory_.push_front(backHistory_.takeLast());
+  }
+  while (backHistory_.size() < position) {
+    backHistory_.push_back(forwardHistory_.takeFirst());
+  }
+}
+
+bool mutableSquareImageContainer::
+writeImageHistory(xmlWriter* writer) const {
+
+  writer->writeTextElement("tool_floss_type", toolFlossType_.prefix());
 
-  QDomElement history(doc->createElement("history"));
-  appendee->appendChild(history);
+  if (backHistory_.empty() && forwardHistory_.empty()) {
+    return true;
+  }
+
+  writer->writeStartElement("history");
 
   if (!backHistory_.empty()) {
-    QDomElement back(doc->createElement("backward_history"));
-    history.appendChild(back);
-    back.setAttribute("count", backHistory_.size());
+    writer->writeStartElement("backward_history");
+    writer->writeAttribute("count", QString::number(backHistory_.size()));
     for (int i = 0, size = backHistory_.size(); i < size; ++i) {
-      backHistory_[i]->toXml(doc, &back);
+      if (!backHistory_[i]->toXml(writer)) {
+        return false;
+      }
     }
+    writer->writeEndElement();
   }
 
   if (!forwardHistory_.empty()) {
-    QDomElement forward(doc->createElement("forward_history"));
-    history.appendChild(forward);
-    forward.setAttribute("count", forwardHistory_.size());
+    writer->writeStartElement("forward_history");
+    writer->writeAttribute("count", QString::number(forwardHistory_.size()));
     for (int i = 0, size = forwardHistory_.size(); i < size; ++i) {
-      forwardHistory_[i]->toXml(doc, &forward);
+      if (!forwardHistory_[i]->toXml(writer)) {
+        return false;
+      }
     }
+    writer->writeEndElement();
   }
+
+  writer->writeEndElement(); // history
+  return true;
 }
 
 void mutableSquareImageContainer::
-updateImageHistory(const QDomElement& element) {
+updateImageHistory(const QString& toolFlossTypePrefix,
+                   const QList<historyItemPtr>& backHistory,
+                   const QList<historyItemPtr>& forwardHistory) {
 
-  const QString toolFlossTypePrefix =
-    ::getElementText(element, "tool_floss_type");
   if (!toolFlossTypePrefix.isNull()) {
     toolFlossType_ = flossType(toolFlossTypePrefix);
   }
 
-  const QDomElement& historyElement = element.firstChildElement("history");
-  // we put everything on forwardHistory_ and then moveHistoryForward()
-  // the number of back_history items
-  QDomElement backElement =
-    historyElement.firstChildElement("backward_history");
-  QDomNodeList backList(backElement.elementsByTagName("history_item"));
-  for (int i = 0, size = backList.size(); i < size; ++i) {
-    forwardHistory_.
-      push_back(historyItem::xmlToHistoryItem(backList.item(i).toElement()));
-  }
+  // we put everything on forwardHistory_ and then move forward over
+  // the back history items
+  forwardHistory_.append(backHistory);
+  forwardHistory_.append(forwardHistory);
+  jumpToHistoryIndex(backHistory_.size() + backHistory.size());
+}
 
-  QDomElement forwardElement =
-    historyElement.firstChildElement("forward_history");
-  QDomNodeList forwardList(forwardElement.elementsByTagName("history_item"));
-  for (int i = 0, size = forwardList.size(); i < size; ++i) {
-    forwardHistory_.
-      push_back(historyItem::xmlToHistoryItem(forwardList.
-                                              item(i).toElement()));
-  }
+void mutableSquareImageContainer::
+restoreBackHistory(const QList<historyItemPtr>& backHistory) {
 
-  // move forward over the back history items
-  for (int i = 0, size = backList.size(); i < size; ++i) {
-    moveHistoryForward();
-  }
+  removeCheckpointsAfter(backHistory_.size());
+  forwardHistory_ = backHistory;
+  jumpToHistoryIndex(backHistory_.size() + backHistory.size());
 }
 
 void mutableSquareImageContainer::rewindAndClearHistory() {
 
-  for (int i = 0, size = backHistory_.size(); i < size; ++i) {
-    moveHistoryBack();
-  }
+  jumpToHistoryIndex(0);
   forwardHistory_.clear();
+  removeCheckpointsAfter(0);
+  checkpointInterval_ = HISTORY_CHECKPOINT_INTERVAL;
 }
 
 dockListUpdate mutableSquareImageContainer::replaceRareColors() {
 
-  QHash<QRgb, int> countHash;
-  ::colorCounts(image_, originalDimension_, &countHash);
-
+  const QHash<QRgb, int> countHash = colorCounts();
   rareColorsDialog countDialog(countHash);
   const int dialogReturnCode = countDialog.exec();
   QList<QRgbPair> pairs = countDialog.colorsToChange();
   if (dialogReturnCode == QDialog::Accepted && pairs.size() > 0) {
-    QList<colorChange> changeHistories;
     QSet<flossColor> oldFloss;
     QVector<triC> oldColors;
     for (int i = 0, size = pairs.size(); i < size; ++i) {
-      const QRgb oldColor = pairs[i].first;
-      const triC oldTriColor(oldColor);
+      const triC oldTriColor(pairs[i].first);
       oldColors.push_back(oldTriColor);
       oldFloss.insert(getFlossColorFromColor(oldTriColor));
-      const QRgb newColor = pairs[i].second;
-      const QVector<pairOfInts> changedSquares =
-        ::changeColor(&image_, oldColor, newColor, originalDimension_);
-      if (!changedSquares.empty()) {
-        removeColor(oldColor);
-        changeHistories.push_back(colorChange(oldColor, newColor,
-                                              changedSquares));
-      }
+    }
+    // make all of the replacements at once
+    const QList<colorChange> changeHistories = remapColors(pairs);
+    for (int i = 0, size = changeHistories.size(); i < size; ++i) {
+      removeColor(changeHistories[i].oldColor());
     }
     addToHistory(historyItemPtr(new rareColorsHistoryItem(changeHistories,
                                                           oldFloss)));
@@ -462,6 +838,33 @@ QImage mutableSquareImageContainer::scaledImage() const {
   return returnImage;
 }
 
+memoryUsage mutableSquareImageContainer::memory() const {
+
+  memoryUsage usage(imageContainer::memory());
+  usage.add(QObject::tr("Color list"),
+            flossColors_.size() * sizeof(flossColor) +
+            colorIndices_.size() * (sizeof(QRgb) + sizeof(int)));
+  // (the hash's buckets, then for each color its hash node and its list's
+  // allocation, stale cells included)
+  qint64 cellBytes = colorCells_.capacity() * sizeof(void*);
+  for (QHash<QRgb, colorCellList>::const_iterator it = colorCells_.begin(),
+         end = colorCells_.end(); it != end; ++it) {
+    cellBytes += sizeof(QHashNode<QRgb, colorCellList>) +
+      sizeof(QArrayData) + it.value().capacity() * sizeof(int);
+  }
+  usage.add(QObject::tr("Color squares index"), cellBytes);
+  qint64 historyBytes = 0;
+  for (int i = 0, size = backHistory_.size(); i < size; ++i) {
+    historyBytes += backHistory_[i]->bytes();
+  }
+  for (int i = 0, size = forwardHistory_.size(); i < size; ++i) {
+    historyBytes += forwardHistory_[i]->bytes();
+  }
+  usage.add(QObject::tr("History"), historyBytes);
+  usage.add(QObject::tr("History checkpoints"), checkpointBytes_);
+  return usage;
+}
+
 QSize immutableSquareImageContainer::setScaledWidth(int widthHint) {
 
   const int newHeight =
@@ -493,7 +896,7 @@ QVector<triC> mutableSquareImageContainer::colors() const {
 flossColor 
 mutableSquareImageContainer::getFlossColorFromColor(const triC& color) const {
 
-  const int foundIndex = flossColors_.indexOf(flossColor(color));
+  const int foundIndex = paletteIndex(color.qrgb());
   if (foundIndex != -1) {
     return flossColors_[foundIndex];
   }
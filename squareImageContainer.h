@@ -20,6 +20,9 @@
 #ifndef SQUAREIMAGECONTAINER_H
 #define SQUAREIMAGECONTAINER_H
 
+#include <QtCore/QHash>
+#include <QtCore/QMap>
+#include <QtCore/QSet>
 #include <QtXml/QDomDocument>
 
 #include "imageContainer.h"
@@ -71,6 +74,20 @@ class squareImageContainer : public imageContainer {
   // Move back one on the history list.
   // Return a dockListUpdate for the history item performed.
   virtual dockListUpdate moveHistoryBack() = 0;
+  // Return the current position on the history list (the number of
+  // items on the back history).
+  virtual int historyIndex() const = 0;
+  // Return the total number of items on the history list.
+  virtual int historyCount() const = 0;
+  // Move to position <index> on the history list, starting from the
+  // nearest history checkpoint when that's closer than the current
+  // position.
+  // Return a dockListUpdate for the net change in colors.
+  virtual dockListUpdate jumpToHistoryIndex(int index) = 0;
+  // Return true if the last history move stopped because a history item's
+  // data couldn't be read back from disk (in which case the image is left
+  // as it was before that item).
+  virtual bool historyReadFailed() const = 0;
   // Return true if the image and its color list should be checked to make
   // sure they're in sync.
   virtual bool colorListCheckNeeded() const = 0;
@@ -95,14 +112,22 @@ class squareImageContainer : public imageContainer {
     performDetailing(const QImage& originalImage,
                      const QList<pixel>& detailSquares,
                      int numColors, flossType type) = 0;
-  // Return the current backward history as xml.
-  virtual QDomDocument backImageHistoryXml() const = 0;
-  // Append the entire edit history as xml to <appendee>.
-  virtual void writeImageHistory(QDomDocument* doc,
-                                 QDomElement* appendee) const = 0;
-  // Restore this image's history from <element>, running back history
-  // if any.
-  virtual void updateImageHistory(const QDomElement& element) = 0;
+  // Return the current backward history (the items are shared, not
+  // copied).
+  virtual QList<historyItemPtr> backHistoryItems() const = 0;
+  // Write the tool floss type and the entire edit history to <writer>;
+  // return false if some of the history couldn't be read back.
+  virtual bool writeImageHistory(xmlWriter* writer) const = 0;
+  // Restore this image's tool floss type and history, running back
+  // history if any.
+  virtual void updateImageHistory(const QString& toolFlossTypePrefix,
+                                  const QList<historyItemPtr>& backHistory,
+                                  const QList<historyItemPtr>& forwardHistory)
+    = 0;
+  // Replace this image's forward history with <backHistory> and move
+  // forward over it.
+  virtual void
+    restoreBackHistory(const QList<historyItemPtr>& backHistory) = 0;
   // Undo back history and then clear both histories.
   virtual void rewindAndClearHistory() = 0;
   // SetScaledSize for (mutable) square images is a set once affair; this
@@ -113,6 +138,79 @@ class squareImageContainer : public imageContainer {
   virtual dockListUpdate replaceRareColors() = 0;
 };
 
+// historyCheckpoint is a compact copy of a mutableSquareImageContainer's
+// image (one pixel per square) and color list at some history position.
+class historyCheckpoint {
+
+ public:
+  historyCheckpoint() {}
+  historyCheckpoint(const QImage& squareColors,
+                    const QVector<flossColor>& colors)
+    : squareColors_(squareColors), colors_(colors) {}
+  const QImage& squareColors() const { return squareColors_; }
+  QVector<flossColor> colors() const { return colors_; }
+  // the approximate memory used by this checkpoint
+  int bytes() const {
+    return squareColors_.bytesPerLine() * squareColors_.height() +
+      colors_.size() * static_cast<int>(sizeof(flossColor));
+  }
+
+ private:
+  QImage squareColors_;
+  QVector<flossColor> colors_;
+};
+
+// colorCellList holds the squares of one color in a
+// mutableSquareImageContainer's image, as cells (yBox*xSquareCount + xBox).
+//
+//// Implementation notes
+//
+// When a square changes color it's appended to its new color's list, but
+// it isn't searched for in its old color's list: that list just counts
+// one square fewer and keeps the cell until it's next compacted.
+// Compacting drops the stale cells (those whose square in the image is
+// no longer the list's color) and duplicates, and sorts what's left.  A
+// list is compacted when its squares are asked for, and whenever it
+// holds more than twice as many cells as squares, so stale cells never
+// cost more than a list's worth of memory.  A compact list that's only
+// appended to in increasing cell order (the squares of a fill, say) stays
+// compact, so reading it doesn't need a sort.
+// The image must be updated before the lists are told about the change,
+// since compacting reads the image.
+//
+class colorCellList {
+
+ public:
+  colorCellList() : count_(0), compact_(true) {}
+  // the number of squares of this color
+  int count() const { return count_; }
+  // the cells, sorted and without stale cells or duplicates if
+  // isCompact()
+  const QVector<int>& cells() const { return cells_; }
+  bool isCompact() const { return compact_; }
+  // the number of cells held (including stale ones and duplicates)
+  int capacity() const { return cells_.capacity(); }
+  // record that the square at <cell> is now this color
+  void add(int cell);
+  // record that the square at <cell> is no longer this color
+  void remove(int cell);
+  // record that all of <other>'s squares are now this color
+  void append(const colorCellList& other);
+  // return true if there are enough stale cells to be worth compacting
+  bool needsCompaction() const;
+  // drop the cells whose square in <image> isn't <color> and sort the
+  // rest; squares are <dimension> pixels on a side and there are
+  // <xSquareCount> squares per row
+  void compact(const QImage& image, QRgb color, int dimension,
+               int xSquareCount);
+
+ private:
+  QVector<int> cells_;
+  int count_;
+  // true if cells_ is sorted and has no stale cells or duplicates
+  bool compact_;
+};
+
 // A mutableSquareImageContainer copies in its image so that it can be
 // altered by the container.
 class mutableSquareImageContainer : public squareImageContainer {
@@ -142,6 +240,20 @@ class mutableSquareImageContainer : public squareImageContainer {
   const QImage& image() const { return image_; }
   QVector<triC> colors() const;
   QVector<flossColor> flossColors() const { return flossColors_; }
+  // Return the index of <color> on flossColors(), or -1 if <color> isn't on
+  // the color list.
+  int paletteIndex(QRgb color) const {
+    return colorIndices_.value(color, -1);
+  }
+  // Return the number of squares of each color in the image (colors not in
+  // the image are absent).
+  QHash<QRgb, int> colorCounts() const;
+  // Return the number of squares of <color> in the image.
+  int colorCount(QRgb color) const {
+    const QHash<QRgb, colorCellList>::const_iterator it =
+      colorCells_.constFind(color);
+    return (it != colorCells_.constEnd()) ? it.value().count() : 0;
+  }
   virtual void setCurrentToolFlossType(flossType type) {
     toolFlossType_ = type;
   }
@@ -161,6 +273,12 @@ class mutableSquareImageContainer : public squareImageContainer {
   bool forwardHistory() const { return !forwardHistory_.isEmpty(); }
   dockListUpdate moveHistoryForward();
   dockListUpdate moveHistoryBack();
+  int historyIndex() const { return backHistory_.size(); }
+  int historyCount() const {
+    return backHistory_.size() + forwardHistory_.size();
+  }
+  dockListUpdate jumpToHistoryIndex(int index);
+  bool historyReadFailed() const { return historyReadFailed_; }
   bool colorListCheckNeeded() const { return colorListCheckNeeded_; }
   QVector<triC> checkColorList();
   dockListUpdate changeColor(QRgb oldColor, flossColor newFlossColor);
@@ -170,9 +288,12 @@ class mutableSquareImageContainer : public squareImageContainer {
   dockListUpdate performDetailing(const QImage& originalImage,
                                   const QList<pixel>& detailSquares,
                                   int numColors, flossType type);
-  QDomDocument backImageHistoryXml() const;
-  void writeImageHistory(QDomDocument* doc, QDomElement* appendee) const;
-  void updateImageHistory(const QDomElement& element);
+  QList<historyItemPtr> backHistoryItems() const { return backHistory_; }
+  bool writeImageHistory(xmlWriter* writer) const;
+  void updateImageHistory(const QString& toolFlossTypePrefix,
+                          const QList<historyItemPtr>& backHistory,
+                          const QList<historyItemPtr>& forwardHistory);
+  void restoreBackHistory(const QList<historyItemPtr>& backHistory);
   void rewindAndClearHistory();
   // Increases or decreases the scaled square size by one.
   QSize zoom(bool zoomIn);
@@ -191,6 +312,7 @@ class mutableSquareImageContainer : public squareImageContainer {
   dockListUpdate replaceRareColors();
   bool isOriginal() const { return false; }
   QImage scaledImage() const;
+  memoryUsage memory() const;
 
  private:
   void drawDetail(int xStart, int yStart, const QColor& color);
@@ -205,15 +327,71 @@ class mutableSquareImageContainer : public squareImageContainer {
     return removeColor(color.color());
   }
   void addToHistory(const historyItemPtr& ptr) {
+    removeCheckpointsAfter(backHistory_.size());
     backHistory_.push_back(ptr);
     forwardHistory_.clear();
+    addCheckpoint();
   }
+  // Record a checkpoint for the current history position if it's on the
+  // checkpoint interval and there isn't one already, then thin out the
+  // checkpoints if they're over their memory limit.
+  void addCheckpoint();
+  // Remove all checkpoints for history positions after <position>.
+  void removeCheckpointsAfter(int position);
+  // Restore the image and color list from the checkpoint at history
+  // <position> and move history items between the back and forward
+  // histories to match.  The restored color list is reconciled with the
+  // restored image, so colors without squares are dropped.
+  void restoreCheckpoint(int position);
+  // (Re)compute colorCells_ from image_.
+  void indexColorCells();
   // Return the flossColor corresponding to <color> on flossColors_.
   flossColor getFlossColorFromColor(const triC& color) const;
+  // Append <color> to flossColors_ (it must not already be there).
+  void appendColor(const flossColor& color) {
+    colorIndices_.insert(color.qrgb(), flossColors_.size());
+    flossColors_.push_back(color);
+  }
+  // Recompute colorIndices_ for flossColors_ entries from <startIndex> on.
+  void reindexColors(int startIndex = 0);
+  // Record in colorCells_ that the square with box coordinates
+  // (<xBox>, <yBox>) was changed from <oldColor> to <newColor>.  Every
+  // edit to image_ must be followed by the corresponding updates (and
+  // image_ must be edited first, see colorCellList).
+  void moveCell(int xBox, int yBox, QRgb oldColor, QRgb newColor);
+  // moveCell for each of <boxCoordinates>
+  void moveCells(const QVector<pairOfInts>& boxCoordinates, QRgb oldColor,
+                 QRgb newColor);
+  // Return the box coordinates of the squares of <color>, in row order.
+  QVector<pairOfInts> colorSquares(QRgb color) const;
+  // Compact <cells>, the list for <color>.
+  void compactCells(QRgb color, colorCellList* cells) const {
+    cells->compact(image_, color, originalDimension_, widthSquareCount_);
+  }
+  // Make all of <oldColor>'s squares in colorCells_ <newColor>'s.
+  void moveAllCells(QRgb oldColor, QRgb newColor);
+  // Change every square of <oldColor> to <newColor>, visiting only the
+  // squares of <oldColor>.  Return the box coordinates of the changed
+  // squares in row order.
+  QVector<pairOfInts> changeColorCells(QRgb oldColor, QRgb newColor);
+  // Replace each <colorMap> first color by its second color in a single
+  // pass over the affected squares.  Return a colorChange for each
+  // pair whose old color was in the image, in <colorMap> order.
+  // (Pairs are applied simultaneously, so a pair's new color should not
+  // also be another pair's old color.)
+  QList<colorChange> remapColors(const QList<QPair<QRgb, QRgb> >& colorMap);
 
  private:
   QImage image_; // the square image (at its original size)
   QVector<flossColor> flossColors_;
+  // the index on flossColors_ of each color on it, so that membership and
+  // lookup don't require scanning the list
+  QHash<QRgb, int> colorIndices_;
+  // the squares of each color in image_, maintained by each edit so that
+  // color counts, unused colors and the squares of a given color can be
+  // found without scanning the image (mutable since reading a color's
+  // squares compacts its list)
+  mutable QHash<QRgb, colorCellList> colorCells_;
   flossType toolFlossType_; // current floss type used by the tools
   const int originalDimension_; // square dimension
   // for convenience: the number of horizontal and vertical squares
@@ -223,6 +401,16 @@ class mutableSquareImageContainer : public squareImageContainer {
   // backHistory
   QList<historyItemPtr> backHistory_;
   QList<historyItemPtr> forwardHistory_;
+  // snapshots of the image and color list keyed by history position
+  // (the number of items on backHistory_ at the time), taken every
+  // checkpointInterval_ positions so that far away history positions can
+  // be reached without performing every history item in between
+  QMap<int, historyCheckpoint> checkpoints_;
+  int checkpointInterval_;
+  int checkpointBytes_; // memory used by checkpoints_
+  // when checkpointBytes_ exceeds this the interval is doubled and every
+  // other checkpoint is dropped
+  const int checkpointByteLimit_;
   // valid_ if flossColors_.size() <= numSymbols && > 0
   bool valid_;
   // set only if valid = false, in which case colors should be set to 0
@@ -232,6 +420,8 @@ class mutableSquareImageContainer : public squareImageContainer {
   // happen, for example, if the user paints over all of one color with a
   // color that already existed)
   bool colorListCheckNeeded_;
+  // set by a history item that couldn't read its data
+  bool historyReadFailed_;
 };
 
 // immutableSquareImageContainer holds a _const_ reference to an image
@@ -260,6 +450,10 @@ class immutableSquareImageContainer : public squareImageContainer {
   bool forwardHistory() const { return false; }
   dockListUpdate moveHistoryForward() { return dockListUpdate(); }
   dockListUpdate moveHistoryBack() { return dockListUpdate(); }
+  int historyIndex() const { return 0; }
+  int historyCount() const { return 0; }
+  dockListUpdate jumpToHistoryIndex(int ) { return dockListUpdate(); }
+  bool historyReadFailed() const { return false; }
   bool colorListCheckNeeded() const { return false; }
   QVector<triC> checkColorList() { return QVector<triC>(); }
   dockListUpdate changeColor(QRgb , flossColor ) {
@@ -276,9 +470,14 @@ class immutableSquareImageContainer : public squareImageContainer {
                                   int , flossType ) {
     return dockListUpdate();
   }
-  QDomDocument backImageHistoryXml() const { return QDomDocument(); }
-  void writeImageHistory(QDomDocument* , QDomElement* ) const { return; }
-  void updateImageHistory(const QDomElement& ) { return; }
+  QList<historyItemPtr> backHistoryItems() const {
+    return QList<historyItemPtr>();
+  }
+  bool writeImageHistory(xmlWriter* ) const { return true; }
+  void updateImageHistory(const QString& ,
+                          const QList<historyItemPtr>& ,
+                          const QList<historyItemPtr>& ) { return; }
+  void restoreBackHistory(const QList<historyItemPtr>& ) { return; }
   void rewindAndClearHistory() { return; }
   QSize setScaledWidth(int widthHint);
   QSize setScaledHeight(int heightHint);
@@ -31,9 +31,21 @@ void squareImageLabel::paintEvent(QPaintEvent* event) {
   // if we're not currently drawing a mouse drag edit, draw the underlying
   // image
   if (!drawingSquares_ && !drawingHashes_) {
-    if (imageIsFlat()) { // paint the entire image at once
-      const QRectF viewRectangle(QRectF(event->rect()));
-      painter.drawPixmap(viewRectangle, scaledImage_, viewRectangle);
+    if (imageIsFlat()) { // paint the exposed part of the image at once
+      if (!flatImageSize_.isEmpty()) {
+        // let the painter scale just the exposed part of baseImage_
+        const qreal xScale =
+          static_cast<qreal>(baseImage_.width())/flatImageSize_.width();
+        const qreal yScale =
+          static_cast<qreal>(baseImage_.height())/flatImageSize_.height();
+        const QRectF viewRectangle = QRectF(event->rect()).
+          intersected(QRectF(QPointF(0, 0), flatImageSize_));
+        const QRectF sourceRectangle(viewRectangle.x() * xScale,
+                                     viewRectangle.y() * yScale,
+                                     viewRectangle.width() * xScale,
+                                     viewRectangle.height() * yScale);
+        painter.drawImage(viewRectangle, baseImage_, sourceRectangle);
+      }
       if (imageIsOriginal_) {
         // no decorations for the original image
         event->accept();
@@ -54,10 +66,9 @@ void squareImageLabel::paintEvent(QPaintEvent* event) {
            j < yEnd; j += scaledDimension_, ++yBox) {
         for (int i = xStart, xBox = xBoxStart;
              i < xEnd; i += scaledDimension_, ++xBox) {
-          painter.drawPixmap
-            (QPoint(i, j),
-             colorSquares_[baseImage_.pixel(xBox*originalDimension,
-                                            yBox*originalDimension)]);
+          painter.fillRect(i, j, scaledDimension_, scaledDimension_,
+                           QColor(baseImage_.pixel(xBox*originalDimension,
+                                                   yBox*originalDimension)));
         }
       }
     }
@@ -139,21 +150,42 @@ void squareImageLabel::paintEvent(QPaintEvent* event) {
   }
 
   if (gridOn_ && scaledDimension_ > 1) {
-    painter.setPen(QPen(QColor(gridColor_), 1));
-    const QRect eventRectangle(event->rect());
-    const int xStart = eventRectangle.x();
-    const int xEnd = xStart + eventRectangle.width();
-    const int yStart = eventRectangle.y();
-    const int yEnd = yStart + eventRectangle.height();
-    for (int i = (xStart/scaledDimension_)*scaledDimension_; i <= xEnd;
-         i += scaledDimension_) {
-      painter.drawLine(QPoint(i, yStart), QPoint(i, yEnd));
-    }
-    for (int j = (yStart/scaledDimension_)*scaledDimension_; j <= yEnd;
-         j += scaledDimension_) {
-      painter.drawLine(QPoint(xStart, j), QPoint(xEnd, j));
+    // the grid is the same everywhere, so instead of drawing each line we
+    // tile the event rectangle with a cached grid overlay whose origin is
+    // aligned with the widget's
+    if (gridTile_.isNull() || gridTileDimension_ != scaledDimension_ ||
+        gridTileColor_ != gridColor_) {
+      generateGridTile();
     }
+    const QRect eventRectangle(event->rect());
+    const int tileWidth = gridTile_.width();
+    const int tileHeight = gridTile_.height();
+    painter.drawTiledPixmap(eventRectangle, gridTile_,
+                            QPoint(eventRectangle.x() % tileWidth,
+                                   eventRectangle.y() % tileHeight));
+  }
+}
+
+void squareImageLabel::generateGridTile() {
+
+  // use a tile that covers a block of squares so that large paints need
+  // only a handful of blits
+  const int squaresPerTile =
+    qMax(1, GRID_TILE_TARGET_SIZE/scaledDimension_);
+  const int tileSize = squaresPerTile * scaledDimension_;
+  gridTile_ = QPixmap(tileSize, tileSize);
+  gridTile_.fill(Qt::transparent);
+  QVector<QLine> gridLines;
+  gridLines.reserve(2 * squaresPerTile);
+  for (int i = 0; i < tileSize; i += scaledDimension_) {
+    gridLines.push_back(QLine(i, 0, i, tileSize - 1));
+    gridLines.push_back(QLine(0, i, tileSize - 1, i));
   }
+  QPainter painter(&gridTile_);
+  painter.setPen(QPen(QColor(gridColor_), 1));
+  painter.drawLines(gridLines);
+  gridTileDimension_ = scaledDimension_;
+  gridTileColor_ = gridColor_;
 }
 
 void squareImageLabel::removeHashSquare(const pixel& p) {
@@ -199,20 +231,15 @@ void squareImageLabel::setNewImage(const QImage& image,
   xSquareCount_ = xSquareCount;
   ySquareCount_ = ySquareCount;
   scaledDimension_ = image.width()/xSquareCount_;
-  generateColorSquares(colors);
-  if (imageIsFlat()) {
-    scaledImage_ = QPixmap::fromImage(baseImage_);
-  }
-  else {
-    scaledImage_ = QPixmap();
-  }
+  squareColors_ = colors;
+  flatImageSize_ = imageIsFlat() ? image.size() : QSize();
 }
 
 void squareImageLabel::updateImage(const QImage& image, const QList<QRgb>& colors,
                                    const QRect& updateRectangle) {
 
   baseImage_ = image;
-  generateColorSquares(colors);
+  squareColors_ = colors;
   if (updateRectangle.isNull()) {
     update();
   }
@@ -226,7 +253,7 @@ void squareImageLabel::setImageSize(const QSize& newSize) {
   if (imageIsFlat()) {
     xSquareCount_ = newSize.width();
     ySquareCount_ = newSize.height();
-    scaledImage_ = QPixmap::fromImage(baseImage_).scaled(newSize);
+    flatImageSize_ = newSize;
   }
   else {
     scaledDimension_ = qMax(newSize.width()/xSquareCount_, 1);
@@ -239,7 +266,6 @@ void squareImageLabel::setImageSize(const QSize& newSize) {
                        ::itoqs(baseImage_.size().width()) + "x" +
                        ::itoqs(baseImage_.size().height())).
                toStdString().c_str());
-    generateColorSquares(colorSquares_.keys());
   }
   resize(newSize);
   update();
@@ -249,7 +275,10 @@ void squareImageLabel::setImageWidth(int newWidth) {
 
   scaledDimension_ = qMax(newWidth/xSquareCount_, 1);
   if (imageIsFlat()) {
-    scaledImage_ = QPixmap::fromImage(baseImage_).scaledToWidth(newWidth);
+    flatImageSize_ = QSize(newWidth,
+                           qRound(baseImage_.height() *
+                                  static_cast<qreal>(newWidth)/
+                                  baseImage_.width()));
   }
   else {
     Q_ASSERT_X(newWidth % scaledDimension_ == 0, "setImageWidth",
@@ -259,7 +288,6 @@ void squareImageLabel::setImageWidth(int newWidth) {
                        ::itoqs(baseImage_.size().width()) + "x" +
                        ::itoqs(baseImage_.size().height())).
                toStdString().c_str());
-    generateColorSquares(colorSquares_.keys());
   }
   resize(size());
   update();
@@ -269,7 +297,10 @@ void squareImageLabel::setImageHeight(int newHeight) {
 
   scaledDimension_ = qMax(newHeight/ySquareCount_, 1);
   if (imageIsFlat()) {
-    scaledImage_ = QPixmap::fromImage(baseImage_).scaledToHeight(newHeight);
+    flatImageSize_ = QSize(qRound(baseImage_.width() *
+                                  static_cast<qreal>(newHeight)/
+                                  baseImage_.height()),
+                           newHeight);
   }
   else {
     Q_ASSERT_X(newHeight % scaledDimension_ == 0, "setImageHeight",
@@ -279,19 +310,7 @@ void squareImageLabel::setImageHeight(int newHeight) {
                        ::itoqs(baseImage_.size().width()) + "x" +
                        ::itoqs(baseImage_.size().height())).
                toStdString().c_str());
-    generateColorSquares(colorSquares_.keys());
   }
   resize(size());
   update();
 }
-
-void squareImageLabel::generateColorSquares(const QList<QRgb>& colors) {
-
-  colorSquares_.clear();
-  for (int i = 0, size = colors.size(); i < size; ++i) {
-    QPixmap thisSquare(scaledDimension_, scaledDimension_);
-    const QRgb thisColor = colors[i];
-    thisSquare.fill(thisColor);
-    colorSquares_[thisColor] = thisSquare;
-  }
-}
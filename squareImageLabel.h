@@ -39,6 +39,7 @@ class squareImageLabel : public imageLabelBase {
   explicit squareImageLabel(QWidget* parent)
     : imageLabelBase(parent), xSquareCount_(0), ySquareCount_(0),
     scaledDimension_(-1), gridOn_(false), gridColor_(qRgb(0, 0, 0)),
+    gridTileDimension_(-1), gridTileColor_(qRgb(0, 0, 0)),
     squareColor_(qRgb(0, 0, 0)), lastSquareDrawn_(0),
     drawingSquares_(false), lastHashDrawn_(0), drawingHashes_(false) {
 
@@ -118,30 +119,40 @@ class squareImageLabel : public imageLabelBase {
   // return true if we paint the image all at once (as opposed to 
   // drawing each square)
   bool imageIsFlat() const {
-    return colorSquares_.isEmpty();
+    return squareColors_.isEmpty();
   }
   int originalHeight() const { return baseImage_.height(); }
-  void generateColorSquares(const QList<QRgb>& colors);
+  // (re)generate gridTile_ for the current scaledDimension_ and gridColor_
+  void generateGridTile();
   void paintEvent(QPaintEvent* event);
 
  private:
   QImage baseImage_;
   bool imageIsOriginal_; // baseImage_ is the Original image
-  // only used when baseImage_ isFlat()
-  QPixmap scaledImage_;
+  // the displayed size of baseImage_ when it isFlat() (there's no scaled
+  // copy - paintEvent scales the exposed part of baseImage_ directly)
+  QSize flatImageSize_;
   
   // number of horizontal squares in baseImage_
   // (just a more convenient way of saying "original square dimension"
   // (but always real scaled width for the original image))
   int xSquareCount_;
   int ySquareCount_; // (for convenience)
-  // key is an image color, value is the square image square to draw for
-  // that color
-  QHash<QRgb, QPixmap> colorSquares_;
+  // the colors of a square image (empty for a flat image); squares are
+  // filled directly with their color, so nothing here grows with the zoom
+  QList<QRgb> squareColors_;
   // square dimension of the scaled image (always 1 for the original image)
   int scaledDimension_;
   bool gridOn_;
   QRgb gridColor_;
+  // approximate width/height of gridTile_ (the actual size is a multiple
+  // of scaledDimension_)
+  static const int GRID_TILE_TARGET_SIZE = 256;
+  // transparent overlay with grid lines on the left/top of each square,
+  // tiled over the image when the grid is on
+  QPixmap gridTile_;
+  int gridTileDimension_; // the scaledDimension_ gridTile_ was made for
+  QRgb gridTileColor_; // the gridColor_ gridTile_ was made for
 
   QRgb squareColor_; // the color to draw drawSquares_ in
   QList<pairOfInts> drawSquares_; // uses box coordinates
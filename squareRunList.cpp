@@ -0,0 +1,411 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "squareRunList.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDebug>
+#include <QtCore/QMap>
+#include <QtCore/QSettings>
+#include <QtCore/QTemporaryFile>
+
+#include "imageUtility.h"
+
+// the spill file is only compacted once it has at least this many bytes
+// of deleted runs (and they're more than half of the file)
+const qint64 SPILL_COMPACT_MIN_DEAD_BYTES = 16 * 1024 * 1024;
+
+// the encoded runs of a squareRunList, either in memory or in the
+// spill file
+class squareRunData : public QSharedData {
+
+ public:
+  squareRunData() : count_(0), fileOffset_(-1), fileBytes_(0),
+    serial_(0), registered_(false) {}
+  ~squareRunData();
+  // set <runs> to the encoded runs, reading them from the spill file if
+  // necessary; return false if they couldn't be read
+  bool runs(QByteArray* runs) const;
+
+  int count_; // number of entries
+  QByteArray runs_; // empty if spilled
+  qint64 fileOffset_; // spill file location, or -1 if in memory
+  int fileBytes_;
+  quint64 serial_; // creation order, for spilling oldest first
+  bool registered_; // true if the spill store is tracking this
+};
+
+// runSpillStore tracks the memory used by squareRunDatas and moves the
+// oldest to a temporary file when the total goes over the memory limit.
+//
+//// Implementation notes
+//
+// The runs of a deleted spilled data become dead space in the file; when
+// the dead space is large and more than the live runs, the live runs are
+// copied to a new file (the old file is kept if that fails).
+class runSpillStore {
+
+ public:
+  static runSpillStore& store() {
+    static runSpillStore theStore;
+    return theStore;
+  }
+  bool enabled() const { return byteLimit_ > 0 && !fileFailed_; }
+  void add(squareRunData* data);
+  void remove(squareRunData* data);
+  // read <bytes> bytes at <offset> into <runs>; return false on failure
+  bool read(qint64 offset, int bytes, QByteArray* runs);
+
+ private:
+  runSpillStore();
+  ~runSpillStore();
+  // write <data>'s runs to the spill file; return false on failure
+  bool spill(squareRunData* data);
+  // copy the live runs to a new file if the old one is mostly dead space
+  void compactIfNeeded();
+
+  // the unspilled datas, oldest first
+  QMap<quint64, squareRunData*> inMemory_;
+  // the spilled datas, oldest first
+  QMap<quint64, squareRunData*> spilled_;
+  qint64 bytesInMemory_;
+  qint64 byteLimit_;
+  quint64 nextSerial_;
+  QTemporaryFile* file_;
+  qint64 fileSize_;
+  // the bytes in the file that belong to spilled_
+  qint64 liveFileBytes_;
+  bool fileFailed_;
+};
+
+runSpillStore::runSpillStore()
+  : bytesInMemory_(0), byteLimit_(0), nextSerial_(0),
+    file_(new QTemporaryFile), fileSize_(0), liveFileBytes_(0),
+    fileFailed_(false) {
+
+  const QSettings settings("cstitch", "cstitch");
+  const qint64 megabytes =
+    settings.value("history_memory_limit", 0).toLongLong();
+  byteLimit_ = qMax(Q_INT64_C(0), megabytes) * 1024 * 1024;
+}
+
+runSpillStore::~runSpillStore() {
+
+  delete file_;
+}
+
+void runSpillStore::add(squareRunData* data) {
+
+  data->serial_ = nextSerial_++;
+  data->registered_ = true;
+  inMemory_.insert(data->serial_, data);
+  bytesInMemory_ += data->runs_.size();
+  while (bytesInMemory_ > byteLimit_ && !inMemory_.isEmpty()) {
+    squareRunData* oldest = inMemory_.begin().value();
+    if (!spill(oldest)) {
+      break;
+    }
+    bytesInMemory_ -= oldest->fileBytes_;
+    inMemory_.erase(inMemory_.begin());
+  }
+}
+
+void runSpillStore::remove(squareRunData* data) {
+
+  const QMap<quint64, squareRunData*>::iterator it =
+    inMemory_.find(data->serial_);
+  if (it != inMemory_.end() && it.value() == data) {
+    bytesInMemory_ -= data->runs_.size();
+    inMemory_.erase(it);
+    return;
+  }
+  const QMap<quint64, squareRunData*>::iterator spilledIt =
+    spilled_.find(data->serial_);
+  if (spilledIt != spilled_.end() && spilledIt.value() == data) {
+    liveFileBytes_ -= data->fileBytes_;
+    spilled_.erase(spilledIt);
+    compactIfNeeded();
+  }
+}
+
+void runSpillStore::compactIfNeeded() {
+
+  const qint64 deadBytes = fileSize_ - liveFileBytes_;
+  if (fileFailed_ || deadBytes < SPILL_COMPACT_MIN_DEAD_BYTES ||
+      deadBytes <= liveFileBytes_) {
+    return;
+  }
+  QTemporaryFile* newFile = new QTemporaryFile;
+  if (!newFile->open()) {
+    qWarning() << "Couldn't open new history spill file" <<
+      newFile->errorString();
+    delete newFile;
+    return;
+  }
+  // (only update the offsets once everything has been copied)
+  QVector<qint64> newOffsets;
+  newOffsets.reserve(spilled_.size());
+  qint64 newSize = 0;
+  for (QMap<quint64, squareRunData*>::const_iterator it = spilled_.begin(),
+         end = spilled_.end(); it != end; ++it) {
+    const squareRunData* data = it.value();
+    QByteArray runs;
+    if (!read(data->fileOffset_, data->fileBytes_, &runs) ||
+        newFile->write(runs) != runs.size()) {
+      qWarning() << "Couldn't compact history spill file" <<
+        newFile->errorString();
+      delete newFile;
+      return;
+    }
+    newOffsets.push_back(newSize);
+    newSize += runs.size();
+  }
+  int i = 0;
+  for (QMap<quint64, squareRunData*>::iterator it = spilled_.begin(),
+         end = spilled_.end(); it != end; ++it, ++i) {
+    it.value()->fileOffset_ = newOffsets[i];
+  }
+  delete file_;
+  file_ = newFile;
+  fileSize_ = newSize;
+}
+
+bool runSpillStore::spill(squareRunData* data) {
+
+  if (fileFailed_) {
+    return false;
+  }
+  if (!file_->isOpen() && !file_->open()) {
+    qWarning() << "Couldn't open history spill file" << file_->errorString();
+    fileFailed_ = true;
+    return false;
+  }
+  const qint64 offset = fileSize_;
+  if (!file_->seek(offset) ||
+      file_->write(data->runs_) != data->runs_.size()) {
+    qWarning() << "Couldn't write history spill file" <<
+      file_->errorString();
+    fileFailed_ = true;
+    return false;
+  }
+  data->fileOffset_ = offset;
+  data->fileBytes_ = data->runs_.size();
+  data->runs_ = QByteArray();
+  fileSize_ += data->fileBytes_;
+  liveFileBytes_ += data->fileBytes_;
+  spilled_.insert(data->serial_, data);
+  return true;
+}
+
+bool runSpillStore::read(qint64 offset, int bytes, QByteArray* runs) {
+
+  if (!file_->seek(offset)) {
+    qWarning() << "Couldn't seek history spill file" << file_->errorString();
+    return false;
+  }
+  *runs = file_->read(bytes);
+  if (runs->size() != bytes) {
+    qWarning() << "Couldn't read history spill file: read" <<
+      runs->size() << "of" << bytes << "bytes at" << offset <<
+      file_->errorString();
+    runs->clear();
+    return false;
+  }
+  return true;
+}
+
+squareRunData::~squareRunData() {
+
+  if (registered_) {
+    runSpillStore::store().remove(this);
+  }
+}
+
+bool squareRunData::runs(QByteArray* runs) const {
+
+  if (fileOffset_ == -1) {
+    *runs = runs_;
+    return true;
+  }
+  return runSpillStore::store().read(fileOffset_, fileBytes_, runs);
+}
+
+// append <value> to <bytes> as a little endian base 128 varint
+static void appendVarint(quint32 value, QByteArray* bytes) {
+
+  while (value >= 0x80) {
+    bytes->append(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  bytes->append(static_cast<char>(value));
+}
+
+// (zig zag encoding keeps small negative numbers small)
+static void appendSignedVarint(qint32 value, QByteArray* bytes) {
+
+  appendVarint((static_cast<quint32>(value) << 1) ^
+               static_cast<quint32>(value >> 31), bytes);
+}
+
+static quint32 readVarint(const QByteArray& bytes, int* position) {
+
+  quint32 value = 0;
+  int shift = 0;
+  while (*position < bytes.size()) {
+    const quint8 byte = static_cast<quint8>(bytes[(*position)++]);
+    value |= static_cast<quint32>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      break;
+    }
+    shift += 7;
+  }
+  return value;
+}
+
+static qint32 readSignedVarint(const QByteArray& bytes, int* position) {
+
+  const quint32 value = readVarint(bytes, position);
+  return static_cast<qint32>(value >> 1) ^ -static_cast<qint32>(value & 1);
+}
+
+squareRunList::squareRunList() : d_(new squareRunData) { }
+
+squareRunList::squareRunList(const QVector<pairOfInts>& coordinates)
+  : d_(new squareRunData) {
+
+  encode(coordinates, QVector<int>(coordinates.size(), 0));
+}
+
+squareRunList::squareRunList(const QVector<pairOfInts>& coordinates,
+                             const QVector<int>& values)
+  : d_(new squareRunData) {
+
+  encode(coordinates, values);
+}
+
+void squareRunList::encode(const QVector<pairOfInts>& coordinates,
+                           const QVector<int>& values) {
+
+  // each run is stored as (y - previous y, x - previous run's last x,
+  // x step, length, value)
+  const int size = coordinates.size();
+  QByteArray& runs = d_->runs_;
+  int lastX = 0;
+  int lastY = 0;
+  int i = 0;
+  while (i < size) {
+    const int x = coordinates[i].x();
+    const int y = coordinates[i].y();
+    const int value = values[i];
+    int step = 0;
+    int length = 1;
+    if (i + 1 < size && coordinates[i + 1].y() == y &&
+        values[i + 1] == value) {
+      step = coordinates[i + 1].x() - x;
+      while (i + length < size && coordinates[i + length].y() == y &&
+             values[i + length] == value &&
+             coordinates[i + length].x() == x + length * step) {
+        ++length;
+      }
+    }
+    appendSignedVarint(y - lastY, &runs);
+    appendSignedVarint(x - lastX, &runs);
+    appendSignedVarint(step, &runs);
+    appendVarint(length, &runs);
+    appendVarint(value, &runs);
+    lastX = x + (length - 1) * step;
+    lastY = y;
+    i += length;
+  }
+  runs.squeeze();
+  d_->count_ = size;
+  runSpillStore& store = runSpillStore::store();
+  if (store.enabled()) {
+    store.add(d_.data());
+  }
+}
+
+squareRunList::squareRunList(const squareRunList& other) : d_(other.d_) { }
+
+squareRunList& squareRunList::operator=(const squareRunList& other) {
+
+  d_ = other.d_;
+  return *this;
+}
+
+squareRunList::~squareRunList() { }
+
+int squareRunList::size() const {
+
+  return d_->count_;
+}
+
+int squareRunList::bytes() const {
+
+  return d_->runs_.size();
+}
+
+QVector<pairOfInts> squareRunList::coordinates() const {
+
+  QVector<pairOfInts> returnCoordinates;
+  decode(&returnCoordinates, NULL);
+  return returnCoordinates;
+}
+
+bool squareRunList::decode(QVector<pairOfInts>* coordinates,
+                           QVector<int>* values) const {
+
+  if (coordinates) {
+    coordinates->clear();
+  }
+  if (values) {
+    values->clear();
+  }
+  QByteArray runs;
+  if (!d_->runs(&runs)) {
+    return false;
+  }
+  if (coordinates) {
+    coordinates->reserve(d_->count_);
+  }
+  if (values) {
+    values->reserve(d_->count_);
+  }
+  int position = 0;
+  int lastX = 0;
+  int lastY = 0;
+  while (position < runs.size()) {
+    const int y = lastY + readSignedVarint(runs, &position);
+    const int x = lastX + readSignedVarint(runs, &position);
+    const int step = readSignedVarint(runs, &position);
+    const int length = readVarint(runs, &position);
+    const int value = readVarint(runs, &position);
+    for (int j = 0; j < length; ++j) {
+      if (coordinates) {
+        coordinates->push_back(pairOfInts(x + j * step, y));
+      }
+      if (values) {
+        values->push_back(value);
+      }
+    }
+    lastX = x + (length - 1) * step;
+    lastY = y;
+  }
+  return true;
+}
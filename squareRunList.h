@@ -0,0 +1,73 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef SQUARERUNLIST_H
+#define SQUARERUNLIST_H
+
+#include <QtCore/QSharedData>
+#include <QtCore/QVector>
+
+class pairOfInts;
+class squareRunData;
+
+// squareRunList is a compact read-only list of square (or pixel)
+// coordinates, each with an integer value (for example an index into a
+// color list).  Consecutive entries on the same row with the same value
+// and evenly spaced x coordinates are stored as a single run, and runs
+// are stored as variable length deltas from the previous run, so a row
+// ordered list of squares costs a few bytes per run instead of eight or
+// more bytes per square.
+//
+// If the "history_memory_limit" setting (in megabytes) is positive then
+// once the lists in memory use more than that the oldest lists are moved
+// to a temporary file and read back from there when decoded.  The file
+// is rewritten without the lists that have since been deleted once those
+// take up most of it.
+class squareRunList {
+
+ public:
+  squareRunList();
+  explicit squareRunList(const QVector<pairOfInts>& coordinates);
+  // <values> must be the same size as <coordinates>
+  squareRunList(const QVector<pairOfInts>& coordinates,
+                const QVector<int>& values);
+  squareRunList(const squareRunList& other);
+  squareRunList& operator=(const squareRunList& other);
+  ~squareRunList();
+  // the number of entries on the list
+  int size() const;
+  bool isEmpty() const { return size() == 0; }
+  // the memory used by the encoded list (0 if it's been moved to disk)
+  int bytes() const;
+  // (empty if the list can't be read back; see decode)
+  QVector<pairOfInts> coordinates() const;
+  // decode the list into <coordinates> and <values> (either may be null);
+  // return false (with both empty) if the list was moved to disk and
+  // can't be read back
+  bool decode(QVector<pairOfInts>* coordinates, QVector<int>* values) const;
+
+ private:
+  // store <coordinates> and <values> as runs in d_
+  void encode(const QVector<pairOfInts>& coordinates,
+              const QVector<int>& values);
+
+  QExplicitlySharedDataPointer<squareRunData> d_;
+};
+
+#endif
@@ -20,15 +20,18 @@
 #include "squareToolHistories.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
+#include <QtCore/QXmlStreamReader>
 
 #include "squareImageContainer.h"
 #include "xmlUtility.h"
 #include "imageUtility.h"
 #include "imageProcessing.h"
 
-historyItemPtr historyItem::xmlToHistoryItem(const QDomElement& xml) {
+historyItemPtr historyItem::xmlToHistoryItem(QXmlStreamReader* reader) {
 
-  const QString tool(::getElementText(xml, "tool"));
+  const QHash<QString, QString> xml = ::readTextElements(reader);
+  const QString tool(xml.value("tool"));
   historyItem* item = NULL;
   if (tool == "change all") {
     item = new changeAllHistoryItem(xml);
@@ -51,31 +54,52 @@ historyItemPtr historyItem::xmlToHistoryItem(const QDomElement& xml) {
   return historyItemPtr(item);
 }
 
-changeAllHistoryItem::changeAllHistoryItem(const QDomElement& xmlHistory)
-  : toolColor_(::xmlStringToFlossColor(::getElementText(xmlHistory,
-                                                        "tool_color"))),
-    toolColorIsNew_(::stringToBool(::getElementText(xmlHistory,
-                                                    "color_is_new"))),
-    priorColor_(::xmlStringToFlossColor(::getElementText(xmlHistory,
-                                                         "old_color"))),
-    coordinates_(::xmlToCoordinatesList(::getElementText(xmlHistory,
-                                                         "coordinate_list")))
+QList<historyItemPtr> historyItem::xmlToHistoryList(QXmlStreamReader* reader) {
+
+  QList<historyItemPtr> items;
+  while (reader->readNextStartElement()) {
+    if (reader->name() == "history_item") {
+      const historyItemPtr item = xmlToHistoryItem(reader);
+      if (item) {
+        items.push_back(item);
+      }
+    }
+    else {
+      reader->skipCurrentElement();
+    }
+  }
+  return items;
+}
+
+changeAllHistoryItem::
+changeAllHistoryItem(const QHash<QString, QString>& xmlHistory)
+  : toolColor_(::xmlStringToFlossColor(xmlHistory.value("tool_color"))),
+    toolColorIsNew_(::stringToBool(xmlHistory.value("color_is_new"))),
+    priorColor_(::xmlStringToFlossColor(xmlHistory.value("old_color"))),
+    coordinates_(::xmlToCoordinatesList(xmlHistory.
+                                        value("coordinate_list")))
 { }
 
-void changeAllHistoryItem::toXml(QDomDocument* doc, QDomElement* appendee)
-  const {
-
-  QDomElement itemElement(doc->createElement("history_item"));
-  appendee->appendChild(itemElement);
-  ::appendTextElement(doc, "tool",  "change all", &itemElement);
-  ::appendTextElement(doc, "tool_color",  ::flossColorToString(toolColor_),
-                      &itemElement);
-  ::appendTextElement(doc, "color_is_new",
-                      ::boolToString(toolColorIsNew_),
-                      &itemElement);
-  ::appendTextElement(doc, "old_color", ::flossColorToString(priorColor_),
-                        &itemElement);
-  ::appendCoordinatesList(doc, coordinates_, &itemElement);
+bool changeAllHistoryItem::toXml(xmlWriter* writer) const {
+
+  QVector<pairOfInts> coordinates;
+  if (!coordinates_.decode(&coordinates, NULL)) {
+    return false;
+  }
+  writer->writeStartElement("history_item");
+  ::writeTextElement(writer, "tool", "change all");
+  ::writeTextElement(writer, "tool_color", ::flossColorToString(toolColor_));
+  ::writeTextElement(writer, "color_is_new",
+                     ::boolToString(toolColorIsNew_));
+  ::writeTextElement(writer, "old_color", ::flossColorToString(priorColor_));
+  ::writeCoordinatesList(writer, coordinates);
+  writer->writeEndElement();
+  return true;
+}
+
+int changeAllHistoryItem::bytes() const {
+
+  return sizeof(*this) + coordinates_.bytes();
 }
 
 dockListUpdate changeAllHistoryItem::
@@ -92,8 +116,14 @@ performHistoryEdit(mutableSquareImageContainer* container,
     removedColor = priorColor_;
   }
 
-  ::changeBlocks(&container->image_, coordinates_,
+  QVector<pairOfInts> coordinates;
+  if (!coordinates_.decode(&coordinates, NULL)) {
+    container->historyReadFailed_ = true;
+    return dockListUpdate();
+  }
+  ::changeBlocks(&container->image_, coordinates,
                  addedColor.qrgb(), container->originalDimension_, true);
+  container->moveCells(coordinates, removedColor.qrgb(), addedColor.qrgb());
 
   if (toolColorIsNew_) {
     container->addColor(addedColor);
@@ -112,26 +142,69 @@ performHistoryEdit(mutableSquareImageContainer* container,
   }
 }
 
-changeOneHistoryItem::changeOneHistoryItem(const QDomElement& xmlHistory)
-  : toolColor_(::xmlStringToFlossColor(::getElementText(xmlHistory,
-                                                        "tool_color"))),
-    toolColorIsNew_(::stringToBool(::getElementText(xmlHistory,
-                                                    "color_is_new"))),
-    pixels_(::xmlToPixelList(::getElementText(xmlHistory, "pixel_list")))
-{ }
+changeOneHistoryItem::
+changeOneHistoryItem(const QHash<QString, QString>& xmlHistory)
+  : toolColor_(::xmlStringToFlossColor(xmlHistory.value("tool_color"))),
+    toolColorIsNew_(::stringToBool(xmlHistory.value("color_is_new"))) {
+
+  setPixels(::xmlToPixelList(xmlHistory.value("pixel_list")));
+}
+
+void changeOneHistoryItem::setPixels(const QVector<pixel>& pixels) {
+
+  QHash<QRgb, int> colorIndices;
+  QVector<pairOfInts> coordinates;
+  QVector<int> indices;
+  coordinates.reserve(pixels.size());
+  indices.reserve(pixels.size());
+  for (int i = 0, size = pixels.size(); i < size; ++i) {
+    const QRgb color = pixels[i].color();
+    QHash<QRgb, int>::const_iterator it = colorIndices.constFind(color);
+    if (it == colorIndices.constEnd()) {
+      it = colorIndices.insert(color, pixelColors_.size());
+      pixelColors_.push_back(color);
+    }
+    coordinates.push_back(pixels[i].coordinates());
+    indices.push_back(it.value());
+  }
+  pixels_ = squareRunList(coordinates, indices);
+}
+
+bool changeOneHistoryItem::pixels(QVector<pixel>* pixels) const {
+
+  pixels->clear();
+  QVector<pairOfInts> coordinates;
+  QVector<int> indices;
+  if (!pixels_.decode(&coordinates, &indices)) {
+    return false;
+  }
+  pixels->reserve(coordinates.size());
+  for (int i = 0, size = coordinates.size(); i < size; ++i) {
+    pixels->push_back(pixel(pixelColors_[indices[i]], coordinates[i]));
+  }
+  return true;
+}
+
+bool changeOneHistoryItem::toXml(xmlWriter* writer) const {
 
-void changeOneHistoryItem::toXml(QDomDocument* doc, QDomElement* appendee)
-  const {
-
-  QDomElement itemElement(doc->createElement("history_item"));
-  appendee->appendChild(itemElement);
-  ::appendTextElement(doc, "tool",  "change one", &itemElement);
-  ::appendTextElement(doc, "tool_color",  ::flossColorToString(toolColor_),
-                      &itemElement);
-  ::appendTextElement(doc, "color_is_new",
-                      ::boolToString(toolColorIsNew_),
-                      &itemElement);
-  ::appendPixelList(doc, pixels_, &itemElement);
+  QVector<pixel> oldPixels;
+  if (!pixels(&oldPixels)) {
+    return false;
+  }
+  writer->writeStartElement("history_item");
+  ::writeTextElement(writer, "tool", "change one");
+  ::writeTextElement(writer, "tool_color", ::flossColorToString(toolColor_));
+  ::writeTextElement(writer, "color_is_new",
+                     ::boolToString(toolColorIsNew_));
+  ::writePixelList(writer, oldPixels);
+  writer->writeEndElement();
+  return true;
+}
+
+int changeOneHistoryItem::bytes() const {
+
+  return sizeof(*this) + pixels_.bytes() +
+    pixelColors_.size() * sizeof(QRgb);
 }
 
 dockListUpdate changeOneHistoryItem::
@@ -139,12 +212,30 @@ performHistoryEdit(mutableSquareImageContainer* container,
                    historyDirection direction) const {
 
   const flossColor newColor = toolColor_;
+  QVector<pixel> oldPixels;
+  if (!pixels(&oldPixels)) {
+    container->historyReadFailed_ = true;
+    return dockListUpdate();
+  }
   if (direction == H_BACK) {
-    ::changeBlocks(&container->image_, pixels_, container->originalDimension_);
+    ::changeBlocks(&container->image_, oldPixels,
+                   container->originalDimension_);
+    const int dimension = container->originalDimension_;
+    for (int i = 0, size = oldPixels.size(); i < size; ++i) {
+      container->moveCell(oldPixels[i].x()/dimension,
+                          oldPixels[i].y()/dimension,
+                          newColor.qrgb(), oldPixels[i].color());
+    }
   }
   else { // forward
-    ::changeBlocks(&container->image_, pixels_, newColor.qrgb(),
+    ::changeBlocks(&container->image_, oldPixels, newColor.qrgb(),
                    container->originalDimension_);
+    const int dimension = container->originalDimension_;
+    for (int i = 0, size = oldPixels.size(); i < size; ++i) {
+      container->moveCell(oldPixels[i].x()/dimension,
+                          oldPixels[i].y()/dimension,
+                          oldPixels[i].color(), newColor.qrgb());
+    }
     container->colorListCheckNeeded_ = true;
   }
   if (toolColorIsNew_) {
@@ -167,31 +258,35 @@ performHistoryEdit(mutableSquareImageContainer* container,
   }
 }
 
-fillRegionHistoryItem::fillRegionHistoryItem(const QDomElement& xmlHistory)
-  : toolColor_(::xmlStringToFlossColor(::getElementText(xmlHistory,
-                                                        "tool_color"))),
-    toolColorIsNew_(::stringToBool(::getElementText(xmlHistory,
-                                                    "color_is_new"))),
-    priorColor_(::xmlStringToFlossColor(::getElementText(xmlHistory,
-                                                         "old_color"))),
-    coordinates_(::xmlToCoordinatesList(::getElementText(xmlHistory,
-                                                         "coordinate_list")))
+fillRegionHistoryItem::
+fillRegionHistoryItem(const QHash<QString, QString>& xmlHistory)
+  : toolColor_(::xmlStringToFlossColor(xmlHistory.value("tool_color"))),
+    toolColorIsNew_(::stringToBool(xmlHistory.value("color_is_new"))),
+    priorColor_(::xmlStringToFlossColor(xmlHistory.value("old_color"))),
+    coordinates_(::xmlToCoordinatesList(xmlHistory.
+                                        value("coordinate_list")))
 { }
 
-void fillRegionHistoryItem::toXml(QDomDocument* doc, QDomElement* appendee)
-  const {
-
-  QDomElement itemElement(doc->createElement("history_item"));
-  appendee->appendChild(itemElement);
-  ::appendTextElement(doc, "tool", "fill region", &itemElement);
-  ::appendTextElement(doc, "tool_color",  ::flossColorToString(toolColor_),
-                      &itemElement);
-  ::appendTextElement(doc, "color_is_new",
-                      ::boolToString(toolColorIsNew_),
-                      &itemElement);
-  ::appendTextElement(doc, "old_color", ::flossColorToString(priorColor_),
-                        &itemElement);
-  ::appendCoordinatesList(doc, coordinates_, &itemElement);
+bool fillRegionHistoryItem::toXml(xmlWriter* writer) const {
+
+  QVector<pairOfInts> coordinates;
+  if (!coordinates_.decode(&coordinates, NULL)) {
+    return false;
+  }
+  writer->writeStartElement("history_item");
+  ::writeTextElement(writer, "tool", "fill region");
+  ::writeTextElement(writer, "tool_color", ::flossColorToString(toolColor_));
+  ::writeTextElement(writer, "color_is_new",
+                     ::boolToString(toolColorIsNew_));
+  ::writeTextElement(writer, "old_color", ::flossColorToString(priorColor_));
+  ::writeCoordinatesList(writer, coordinates);
+  writer->writeEndElement();
+  return true;
+}
+
+int fillRegionHistoryItem::bytes() const {
+
+  return sizeof(*this) + coordinates_.bytes();
 }
 
 dockListUpdate fillRegionHistoryItem::
@@ -199,13 +294,20 @@ performHistoryEdit(mutableSquareImageContainer* container,
                    historyDirection direction) const {
 
   const flossColor newColor = toolColor_;
+  QVector<pairOfInts> coordinates;
+  if (!coordinates_.decode(&coordinates, NULL)) {
+    container->historyReadFailed_ = true;
+    return dockListUpdate();
+  }
   if (direction == H_BACK) {
-    ::changeBlocks(&container->image_, coordinates_, priorColor_.qrgb(),
+    ::changeBlocks(&container->image_, coordinates, priorColor_.qrgb(),
                    container->originalDimension_, true);
+    container->moveCells(coordinates, newColor.qrgb(), priorColor_.qrgb());
   }
   else { // forward
-    ::changeBlocks(&container->image_, coordinates_, newColor.qrgb(),
+    ::changeBlocks(&container->image_, coordinates, newColor.qrgb(),
                    container->originalDimension_, true);
+    container->moveCells(coordinates, priorColor_.qrgb(), newColor.qrgb());
     container->colorListCheckNeeded_ = true;
   }
   if (toolColorIsNew_) {
@@ -233,34 +335,101 @@ performHistoryEdit(mutableSquareImageContainer* container,
   }
 }
 
-detailHistoryItem::detailHistoryItem(const QDomElement& xmlHistory)
-  : detailPixels_(::xmlToHistoryPixelList(::getElementText(xmlHistory,
-                                                           "history_pixel_list"))),
-    newColorsType_(::getElementText(xmlHistory, "new_colors_type"))
-{}
-
-void detailHistoryItem::toXml(QDomDocument* doc, QDomElement* appendee)
-  const {
-
-  QDomElement itemElement(doc->createElement("history_item"));
-  appendee->appendChild(itemElement);
-  ::appendTextElement(doc, "tool", "detail", &itemElement);
-  ::appendHistoryPixelList(doc, detailPixels_, &itemElement);
-  ::appendTextElement(doc, "new_colors_type", newColorsType_.prefix(),
-                      &itemElement);
+detailHistoryItem::
+detailHistoryItem(const QHash<QString, QString>& xmlHistory)
+  : newColorsType_(xmlHistory.value("new_colors_type")) {
+
+  setDetailPixels(::xmlToHistoryPixelList(xmlHistory.
+                                          value("history_pixel_list")));
+}
+
+void detailHistoryItem::
+setDetailPixels(const QVector<historyPixel>& detailPixels) {
+
+  // index the distinct (old color, new color, new color is new) triples
+  QHash<QPair<QPair<QRgb, QRgb>, int>, int> colorIndices;
+  QVector<pairOfInts> coordinates;
+  QVector<int> indices;
+  coordinates.reserve(detailPixels.size());
+  indices.reserve(detailPixels.size());
+  for (int i = 0, size = detailPixels.size(); i < size; ++i) {
+    const historyPixel& thisPixel = detailPixels[i];
+    const QPair<QPair<QRgb, QRgb>, int>
+      key(qMakePair(thisPixel.oldColor().qrgb(), thisPixel.newColor().qrgb()),
+          thisPixel.newColorIsNew() ? 1 : 0);
+    QHash<QPair<QPair<QRgb, QRgb>, int>, int>::const_iterator it =
+      colorIndices.constFind(key);
+    if (it == colorIndices.constEnd()) {
+      it = colorIndices.insert(key, detailColors_.size());
+      detailColors_.push_back(historyPixel(pairOfInts(0, 0),
+                                           key.first.first, key.first.second,
+                                           key.second != 0));
+    }
+    coordinates.push_back(pairOfInts(thisPixel.x(), thisPixel.y()));
+    indices.push_back(it.value());
+  }
+  detailPixels_ = squareRunList(coordinates, indices);
+}
+
+bool detailHistoryItem::
+detailPixels(QVector<historyPixel>* detailPixels) const {
+
+  detailPixels->clear();
+  QVector<pairOfInts> coordinates;
+  QVector<int> indices;
+  if (!detailPixels_.decode(&coordinates, &indices)) {
+    return false;
+  }
+  detailPixels->reserve(coordinates.size());
+  for (int i = 0, size = coordinates.size(); i < size; ++i) {
+    const historyPixel& colors = detailColors_[indices[i]];
+    detailPixels->push_back(historyPixel(coordinates[i],
+                                         colors.oldColor().qrgb(),
+                                         colors.newColor().qrgb(),
+                                         colors.newColorIsNew()));
+  }
+  return true;
+}
+
+bool detailHistoryItem::toXml(xmlWriter* writer) const {
+
+  QVector<historyPixel> pixels;
+  if (!detailPixels(&pixels)) {
+    return false;
+  }
+  writer->writeStartElement("history_item");
+  ::writeTextElement(writer, "tool", "detail");
+  ::writeHistoryPixelList(writer, pixels);
+  ::writeTextElement(writer, "new_colors_type", newColorsType_.prefix());
+  writer->writeEndElement();
+  return true;
+}
+
+int detailHistoryItem::bytes() const {
+
+  return sizeof(*this) + detailPixels_.bytes() +
+    detailColors_.size() * sizeof(historyPixel);
 }
 
 dockListUpdate detailHistoryItem::
 performHistoryEdit(mutableSquareImageContainer* container,
                    historyDirection direction) const {
 
+  QVector<historyPixel> pixels;
+  if (!detailPixels(&pixels)) {
+    container->historyReadFailed_ = true;
+    return dockListUpdate();
+  }
   if (direction == H_BACK) {
     QVector<triC> colorsToRemove;
-    for (int i = 0, size = detailPixels_.size(); i < size; ++i) {
-      const historyPixel thisPixel = detailPixels_[i];
+    for (int i = 0, size = pixels.size(); i < size; ++i) {
+      const historyPixel thisPixel = pixels[i];
       ::changeOneBlock(&container->image_, thisPixel.x(), thisPixel.y(),
                        thisPixel.oldColor().qrgb(),
                        container->originalDimension_, true);
+      container->moveCell(thisPixel.x(), thisPixel.y(),
+                          thisPixel.newColor().qrgb(),
+                          thisPixel.oldColor().qrgb());
       if (thisPixel.newColorIsNew()) {
         colorsToRemove.push_back(thisPixel.newColor());
       }
@@ -270,11 +439,14 @@ performHistoryEdit(mutableSquareImageContainer* container,
   }
   else { // forward
     QVector<flossColor> colorsToAdd;
-    for (int i = 0, size = detailPixels_.size(); i < size; ++i) {
-      const historyPixel thisPixel = detailPixels_[i];
+    for (int i = 0, size = pixels.size(); i < size; ++i) {
+      const historyPixel thisPixel = pixels[i];
       ::changeOneBlock(&container->image_, thisPixel.x(), thisPixel.y(),
                        thisPixel.newColor().qrgb(),
                        container->originalDimension_, true);
+      container->moveCell(thisPixel.x(), thisPixel.y(),
+                          thisPixel.oldColor().qrgb(),
+                          thisPixel.newColor().qrgb());
       if (thisPixel.newColorIsNew()) {
         const triC newColor = thisPixel.newColor();
         colorsToAdd.push_back(flossColor(newColor, newColorsType_));
@@ -286,33 +458,87 @@ performHistoryEdit(mutableSquareImageContainer* container,
   }
 }
 
-rareColorsHistoryItem::rareColorsHistoryItem(const QDomElement& xmlHistory)
-  : items_(::xmlToColorChangeList(::getElementText(xmlHistory,
-                                                   "color_change_list"))),
-    rareColorTypes_(::xmlStringToFlossSet(::getElementText(xmlHistory,
-                                                           "floss_list"))) {}
+rareColorsHistoryItem::
+rareColorsHistoryItem(const QHash<QString, QString>& xmlHistory)
+  : rareColorTypes_(::xmlStringToFlossSet(xmlHistory.value("floss_list"))) {
 
-void rareColorsHistoryItem::toXml(QDomDocument* doc, QDomElement* appendee)
-  const {
+  setItems(::xmlToColorChangeList(xmlHistory.value("color_change_list")));
+}
 
-  QDomElement itemElement(doc->createElement("history_item"));
-  appendee->appendChild(itemElement);
-  ::appendTextElement(doc, "tool", "rare colors", &itemElement);
-  ::appendColorChangeHistoryList(doc, items_, &itemElement);
-  ::appendFlossList(doc, rareColorTypes_, &itemElement);
+void rareColorsHistoryItem::setItems(const QList<colorChange>& items) {
+
+  QVector<pairOfInts> coordinates;
+  QVector<int> indices;
+  for (int i = 0, size = items.size(); i < size; ++i) {
+    const QVector<pairOfInts> itemCoordinates = items[i].coordinates();
+    coordinates += itemCoordinates;
+    indices += QVector<int>(itemCoordinates.size(), i);
+    changeColors_.push_back(qMakePair(items[i].oldColor(),
+                                      items[i].newColor()));
+  }
+  changes_ = squareRunList(coordinates, indices);
+}
+
+bool rareColorsHistoryItem::items(QList<colorChange>* items) const {
+
+  items->clear();
+  QVector<pairOfInts> coordinates;
+  QVector<int> indices;
+  if (!changes_.decode(&coordinates, &indices)) {
+    return false;
+  }
+  // (a change with no coordinates still gets an item)
+  QVector<QVector<pairOfInts> > itemCoordinates(changeColors_.size());
+  for (int i = 0, size = coordinates.size(); i < size; ++i) {
+    itemCoordinates[indices[i]].push_back(coordinates[i]);
+  }
+  for (int i = 0, size = changeColors_.size(); i < size; ++i) {
+    items->push_back(colorChange(changeColors_[i].first,
+                                 changeColors_[i].second,
+                                 itemCoordinates[i]));
+  }
+  return true;
+}
+
+bool rareColorsHistoryItem::toXml(xmlWriter* writer) const {
+
+  QList<colorChange> changes;
+  if (!items(&changes)) {
+    return false;
+  }
+  writer->writeStartElement("history_item");
+  ::writeTextElement(writer, "tool", "rare colors");
+  ::writeColorChangeHistoryList(writer, changes);
+  ::writeFlossList(writer, rareColorTypes_);
+  writer->writeEndElement();
+  return true;
+}
+
+int rareColorsHistoryItem::bytes() const {
+
+  return sizeof(*this) + changes_.bytes() +
+    changeColors_.size() * sizeof(QPair<QRgb, QRgb>) +
+    rareColorTypes_.size() * sizeof(flossColor);
 }
 
 dockListUpdate rareColorsHistoryItem::
 performHistoryEdit(mutableSquareImageContainer* container,
                    historyDirection direction) const {
 
+  QList<colorChange> changes;
+  if (!items(&changes)) {
+    container->historyReadFailed_ = true;
+    return dockListUpdate();
+  }
   if (direction == H_BACK) {
+    ::applyColorChanges(&container->image_, changes,
+                        container->originalDimension_, true);
     QVector<flossColor> colorsToAdd;
-    for (int i = 0, size = items_.size(); i < size; ++i) {
-      const colorChange thisColorChange = items_[i];
+    for (int i = 0, size = changes.size(); i < size; ++i) {
+      const colorChange thisColorChange = changes[i];
       const triC oldColor = thisColorChange.oldColor();
-      ::changeBlocks(&container->image_, thisColorChange.coordinates(),
-                     oldColor.qrgb(), container->originalDimension_, true);
+      container->moveCells(thisColorChange.coordinates(),
+                           thisColorChange.newColor(), oldColor.qrgb());
       const QSet<flossColor>::const_iterator it =
         rareColorTypes_.constFind(flossColor(oldColor));
       if (it != rareColorTypes_.constEnd()) {
@@ -330,12 +556,14 @@ performHistoryEdit(mutableSquareImageContainer* container,
     return dockListUpdate(colorsToAdd);
   }
   else { // forward
+    ::applyColorChanges(&container->image_, changes,
+                        container->originalDimension_);
     QVector<triC> colorsToRemove;
-    for (int i = 0, size = items_.size(); i < size; ++i) {
-      const colorChange thisColorChange = items_[i];
-      ::changeBlocks(&container->image_, thisColorChange.coordinates(),
-                     thisColorChange.newColor(), container->originalDimension_,
-                     true);
+    for (int i = 0, size = changes.size(); i < size; ++i) {
+      const colorChange thisColorChange = changes[i];
+      container->moveCells(thisColorChange.coordinates(),
+                           thisColorChange.oldColor(),
+                           thisColorChange.newColor());
       colorsToRemove.push_back(thisColorChange.oldColor());
     }
     container->removeColors(colorsToRemove);
@@ -20,11 +20,13 @@
 #ifndef SQUARETOOLHISTORIES_H
 #define SQUARETOOLHISTORIES_H
 
+#include <QtCore/QPair>
 #include <QtCore/QSharedData>
 
 #include "triC.h"
 #include "floss.h"
 #include "squareDockTools.h"
+#include "squareRunList.h"
 
 class pairOfInts;
 class pixel;
@@ -32,8 +34,9 @@ class historyPixel;
 class colorChange;
 class mutableSquareImageContainer;
 class historyItem;
-class QDomDocument;
-class QDomElement;
+class QXmlStreamReader;
+class xmlWriter;
+template<class K, class V> class QHash;
 template<class T> class QExplicitlySharedDataPointer;
 
 typedef QExplicitlySharedDataPointer<historyItem> historyItemPtr;
@@ -61,6 +64,10 @@ class dockListUpdate {
   dockListUpdate(const QVector<triC>& colorsToRemove)
     : singleColor_(false), colorIsNew_(false),
       colorsToRemove_(colorsToRemove) {}
+  dockListUpdate(const QVector<flossColor>& colorsToAdd,
+                 const QVector<triC>& colorsToRemove)
+    : singleColor_(false), colorsToAdd_(colorsToAdd), colorIsNew_(false),
+      colorsToRemove_(colorsToRemove) {}
   // return true if the update is for a single color
   bool singleColor() const { return singleColor_; }
   // return true if the tool color for this update is a color that wasn't
@@ -88,16 +95,23 @@ class historyItem : public QSharedData {
 
  public :
   virtual ~historyItem() {}
-  // append the xml version of this history item to <appendee>
-  virtual void toXml(QDomDocument* doc, QDomElement* appendee) const = 0;
+  // write the xml version of this history item to <writer>; return false
+  // (without writing anything) if the item's data couldn't be read back
+  virtual bool toXml(xmlWriter* writer) const = 0;
   // perform a history edit on <container> given the data of this history
   // item and the <direction> of the edit (forward or backward)
   virtual dockListUpdate
     performHistoryEdit(mutableSquareImageContainer* container,
                        historyDirection direction) const = 0;
+  // return the memory held by this history item
+  virtual int bytes() const = 0;
   // a "factory" that returns a historyItem pointer to a derived history
-  // item whose type and data are determined by the <xml> content
-  static historyItemPtr xmlToHistoryItem(const QDomElement& xml);
+  // item whose type and data are determined by the history_item element
+  // <reader> is on (the element is read through its end tag)
+  static historyItemPtr xmlToHistoryItem(QXmlStreamReader* reader);
+  // read the history_item elements of the history list element <reader>
+  // is on (through its end tag)
+  static QList<historyItemPtr> xmlToHistoryList(QXmlStreamReader* reader);
 };
 
 class changeAllHistoryItem : public historyItem {
@@ -108,19 +122,22 @@ class changeAllHistoryItem : public historyItem {
                        const QVector<pairOfInts>& coordinates)
     : toolColor_(toolColor), toolColorIsNew_(toolColorIsNew),
       priorColor_(oldColor), coordinates_(coordinates) {}
-  explicit changeAllHistoryItem(const QDomElement& xmlHistory);
-  void toXml(QDomDocument* doc, QDomElement* appendee) const;
+  explicit changeAllHistoryItem(const QHash<QString, QString>& xmlHistory);
+  bool toXml(xmlWriter* writer) const;
   dockListUpdate performHistoryEdit(mutableSquareImageContainer* container,
                                     historyDirection direction) const;
+  int bytes() const;
   flossColor toolColor() const { return toolColor_; }
   flossColor oldColor() const { return priorColor_; }
-  QVector<pairOfInts> coordinates() const { return coordinates_; }
+  QVector<pairOfInts> coordinates() const {
+    return coordinates_.coordinates();
+  }
 
  private:
   const flossColor toolColor_; // the color associated with the tool used
   const bool toolColorIsNew_; // true if the tool color didn't exist before
   const flossColor priorColor_; // the color being painted over
-  const QVector<pairOfInts> coordinates_; // the coordinates painted over
+  const squareRunList coordinates_; // the coordinates painted over
 };
 
 class changeOneHistoryItem : public historyItem {
@@ -128,17 +145,28 @@ class changeOneHistoryItem : public historyItem {
  public:
   changeOneHistoryItem(flossColor toolColor, bool toolColorIsNew,
                        const QVector<pixel>& pixels)
-    :  toolColor_(toolColor), toolColorIsNew_(toolColorIsNew),
-       pixels_(pixels) {}
-  explicit changeOneHistoryItem(const QDomElement& xmlHistory);
-  void toXml(QDomDocument* doc, QDomElement* appendee) const;
+    :  toolColor_(toolColor), toolColorIsNew_(toolColorIsNew) {
+    setPixels(pixels);
+  }
+  explicit changeOneHistoryItem(const QHash<QString, QString>& xmlHistory);
+  bool toXml(xmlWriter* writer) const;
   dockListUpdate performHistoryEdit(mutableSquareImageContainer* container,
                                     historyDirection direction) const;
+  int bytes() const;
 
  private:
+  // store <pixels> in pixels_ and pixelColors_
+  void setPixels(const QVector<pixel>& pixels);
+  // set <pixels> to the old pixels we've changed; return false if they
+  // couldn't be read
+  bool pixels(QVector<pixel>* pixels) const;
+
   const flossColor toolColor_; // the color associated with the tool used
   const bool toolColorIsNew_; // true if the tool color didn't exist before
-  const QVector<pixel> pixels_; // the old pixels we've changed
+  // the (pixel) coordinates of the old pixels we've changed, with values
+  // indexing their colors on pixelColors_
+  squareRunList pixels_;
+  QVector<QRgb> pixelColors_;
 };
 
 class fillRegionHistoryItem : public historyItem {
@@ -149,17 +177,18 @@ class fillRegionHistoryItem : public historyItem {
                         const QVector<pairOfInts>& coordinates)
     :  toolColor_(toolColor), toolColorIsNew_(toolColorIsNew),
        priorColor_(oldColor), coordinates_(coordinates) {}
-  explicit fillRegionHistoryItem(const QDomElement& xmlHistory);
-  void toXml(QDomDocument* doc, QDomElement* appendee) const;
+  explicit fillRegionHistoryItem(const QHash<QString, QString>& xmlHistory);
+  bool toXml(xmlWriter* writer) const;
   dockListUpdate performHistoryEdit(mutableSquareImageContainer* container,
                                     historyDirection direction) const;
+  int bytes() const;
 
  private:
   const flossColor toolColor_; // the color associated with the tool used
   const bool toolColorIsNew_; // true if the tool color didn't exist before
   const flossColor priorColor_; // the color being painted over
   // square coordinates of the squares painted over
-  const QVector<pairOfInts> coordinates_;
+  const squareRunList coordinates_;
 };
 
 class detailHistoryItem : public historyItem {
@@ -168,14 +197,27 @@ class detailHistoryItem : public historyItem {
   // <newColorsType> is the floss type of the new detail colors
   explicit detailHistoryItem(const QVector<historyPixel>& detailPixels,
                              flossType newColorsType)
-    : detailPixels_(detailPixels), newColorsType_(newColorsType) {}
-  explicit detailHistoryItem(const QDomElement& xmlHistory);
-  void toXml(QDomDocument* doc, QDomElement* appendee) const;
+    : newColorsType_(newColorsType) {
+    setDetailPixels(detailPixels);
+  }
+  explicit detailHistoryItem(const QHash<QString, QString>& xmlHistory);
+  bool toXml(xmlWriter* writer) const;
   dockListUpdate performHistoryEdit(mutableSquareImageContainer* container,
                                     historyDirection direction) const;
+  int bytes() const;
 
  private:
-  const QVector<historyPixel> detailPixels_;
+  // store <detailPixels> in detailPixels_ and detailColors_
+  void setDetailPixels(const QVector<historyPixel>& detailPixels);
+  // set <detailPixels> to the detailed pixels; return false if they
+  // couldn't be read
+  bool detailPixels(QVector<historyPixel>* detailPixels) const;
+
+  // the (square) coordinates of the detailed squares, with values indexing
+  // their color changes on detailColors_
+  squareRunList detailPixels_;
+  // the distinct color changes in detailPixels_ (with 0 coordinates)
+  QVector<historyPixel> detailColors_;
   // floss type of the new colors in detailPixels_
   const flossType newColorsType_;
 };
@@ -185,15 +227,27 @@ class rareColorsHistoryItem : public historyItem {
  public:
   rareColorsHistoryItem(const QList<colorChange>& items,
                         const QSet<flossColor>& rareColorTypes)
-    : items_(items), rareColorTypes_(rareColorTypes) {}
-  explicit rareColorsHistoryItem(const QDomElement& xmlHistory);
-  void toXml(QDomDocument* doc, QDomElement* appendee) const;
+    : rareColorTypes_(rareColorTypes) {
+    setItems(items);
+  }
+  explicit rareColorsHistoryItem(const QHash<QString, QString>& xmlHistory);
+  bool toXml(xmlWriter* writer) const;
   dockListUpdate performHistoryEdit(mutableSquareImageContainer* container,
                                     historyDirection direction) const;
+  int bytes() const;
 
  private:
-  // a changeAllHistoryItem for each rare color that is replaced
-  const QList<colorChange> items_;
+  // store <items> in changes_ and changeColors_
+  void setItems(const QList<colorChange>& items);
+  // set <items> to the color changes we've made, one for each rare color
+  // that was replaced; return false if they couldn't be read
+  bool items(QList<colorChange>* items) const;
+
+  // the (square) coordinates of all of the changes, with values indexing
+  // their (old color, new color) on changeColors_
+  squareRunList changes_;
+  // the colors of each color change, in order
+  QVector<QPair<QRgb, QRgb> > changeColors_;
   // floss types of the rare colors that got replaced
   const QSet<flossColor> rareColorTypes_;
 };
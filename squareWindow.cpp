@@ -499,8 +499,10 @@ void squareWindow::processPatternButton(squareImagePtr image,
   }
   const int parentIndex = imageNameToIndex(image->name());
   const int squareDimension = image->originalDimension();
+  // (the pattern shares image's pixels and history items until image is
+  // edited)
   const patternWindowSaver saver(patternIndex, parentIndex, squareDimension,
-                                 image->backImageHistoryXml());
+                                 image->backHistoryItems());
   winManager()->addPatternWindow(image->image(),
                                  squareDimension,
                                  image->flossColors(),
@@ -807,16 +809,34 @@ void squareWindow::curImageUpdated(const dockListUpdate& update,
   updateHistoryButtonStates();
 }
 
+// tell the user that a history move stopped because the history
+// couldn't be read back from disk
+static void reportHistoryReadFailure(QWidget* parent) {
+
+  QMessageBox::critical(parent, QObject::tr("History lost"),
+                        QObject::tr("Sorry, part of this image's edit "
+                                    "history couldn't be read back from "
+                                    "its temporary file, so the image can't "
+                                    "be moved past that point in its "
+                                    "history."));
+}
+
 void squareWindow::processForwardHistoryAction() {
 
   const dockListUpdate update = curImage_->moveHistoryForward();
   curImageUpdated(update);
+  if (curImage_->historyReadFailed()) {
+    ::reportHistoryReadFailure(this);
+  }
 }
 
 void squareWindow::processBackHistoryAction() {
 
   const dockListUpdate update = curImage_->moveHistoryBack();
   curImageUpdated(update);
+  if (curImage_->historyReadFailed()) {
+    ::reportHistoryReadFailure(this);
+  }
 }
 
 QImage squareWindow::curImageForSaving() const {
@@ -872,7 +892,8 @@ void squareWindow::displayImageInfo() {
                                .arg(::itoqs(height))
                                .arg(::itoqs(squareDim))
                                .arg(::itoqs(xBoxes))
-                               .arg(::itoqs(yBoxes)));
+                               .arg(::itoqs(yBoxes)) +
+                               imageInfoMemoryString(curImage_->memory()));
     }
     else {
       QMessageBox::information(this, curImage_->name(),
@@ -884,8 +905,8 @@ void squareWindow::displayImageInfo() {
                                .arg(::itoqs(squareDim))
                                .arg(::itoqs(xBoxes))
                                .arg(::itoqs(yBoxes))
-                               .arg(flossString));
-                                    
+                               .arg(flossString) +
+                               imageInfoMemoryString(curImage_->memory()));
     }
   }
 }
@@ -895,25 +916,31 @@ void squareWindow::imageDeleted(int imageIndex) {
   winManager()->squareWindowImageDeleted(imageIndex);
 }
 
-void squareWindow::writeCurrentHistory(QDomDocument* doc,
-                                       QDomElement* appendee,
+bool squareWindow::writeCurrentHistory(xmlWriter* writer,
                                        int imageIndex) {
 
   squareImagePtr container = squareImageFromIndex(imageIndex);
   if (container) {
-    container->writeImageHistory(doc, appendee);
+    return container->writeImageHistory(writer);
   }
   else {
     qWarning() << "Lost image in imageHistoryFromIndex:" << imageIndex;
+    return true;
   }
 }
 
-void squareWindow::updateImageHistory(const QDomElement& xml) {
+void squareWindow::
+updateImageHistory(int imageIndex, const QString& toolFlossTypePrefix,
+                   const QList<historyItemPtr>& backHistory,
+                   const QList<historyItemPtr>& forwardHistory) {
 
-  const int imageIndex = ::getElementText(xml, "index").toInt();
   squareImagePtr container = squareImageFromIndex(imageIndex);
   if (container) {
-    container->updateImageHistory(xml);
+    container->updateImageHistory(toolFlossTypePrefix, backHistory,
+                                  forwardHistory);
+    if (container->historyReadFailed()) {
+      ::reportHistoryReadFailure(this);
+    }
   }
   else {
     qWarning() << "Lost image in updateImageHistory:" << imageIndex;
@@ -925,9 +952,7 @@ void squareWindow::recreatePatternImage(const patternWindowSaver& saver) {
   squareImagePtr thisImage =
     squareImageFromIndex(saver.parentIndex());
   if (thisImage) {
-    QDomElement historyElement(saver.squareHistory().
-                               firstChildElement("square_history"));
-    thisImage->updateImageHistory(historyElement);
+    thisImage->restoreBackHistory(saver.squareHistory());
     processPatternButton(thisImage, saver.index());
     thisImage->rewindAndClearHistory();
   }
@@ -154,13 +154,16 @@ class squareWindow : public imageCompareBase {
   // recreate a pattern image using the data in <saver> as part of a
   // project restore
   void recreatePatternImage(const patternWindowSaver& saver);
-  // append the current history and tool floss mode of the image with
-  // index <imageIndex> to <appendee> as xml
-  void writeCurrentHistory(QDomDocument* doc, QDomElement* appendee,
-                           int imageIndex);
-  // update the edit history of the image whose information is contained
-  // in <xml> and run the back history if it exists
-  void updateImageHistory(const QDomElement& xml);
+  // write the current history and tool floss mode of the image with
+  // index <imageIndex> to <writer>; return false if some of the history
+  // couldn't be read back
+  bool writeCurrentHistory(xmlWriter* writer, int imageIndex);
+  // update the tool floss mode and edit history of the image with index
+  // <imageIndex> and run the back history if it exists
+  void updateImageHistory(int imageIndex,
+                          const QString& toolFlossTypePrefix,
+                          const QList<historyItemPtr>& backHistory,
+                          const QList<historyItemPtr>& forwardHistory);
   void appendCurrentSettings(QDomDocument* doc,
                              QDomElement* appendee) const; //override;
   QString updateCurrentSettings(const QDomElement& xml); //override;
@@ -22,6 +22,7 @@
 #include <algorithm>
 
 #include <QtCore/QDebug>
+#include <QtConcurrent/QtConcurrentMap>
 
 #include <QFontDatabase>
 #include <QPainter>
@@ -29,10 +30,15 @@
 
 #include "utility.h"
 #include "imageProcessing.h"
+#include "memoryUsage.h"
 
 extern const int MAX_NUM_SYMBOL_TYPES = 4;
+// maximum total number of pixels held by the symbol cache (about 64MB)
+const int SYMBOL_CACHE_MAX_PIXELS = 16 * 1024 * 1024;
 QVector<QChar> symbolChooser::unicodeCharacters_ = QVector<QChar>();
 symbolChooser::cheapFont symbolChooser::unicodeFont_ = symbolChooser::cheapFont();
+QCache<symbolChooser::symbolKey, QPixmap>
+  symbolChooser::symbolCache_(SYMBOL_CACHE_MAX_PIXELS);
 
 // functor for comparing two triCs by intensity
 class triCIntensityDefinite {
@@ -48,6 +54,11 @@ symbolChooser::symbolChooser(int symbolDimension, const QVector<triC>& colors,
     borderDimension_(borderDimension) {
 
   std::sort(colors_.begin(), colors_.end(), triCIntensityDefinite());
+  static bool cacheCleanupRegistered = false;
+  if (!cacheCleanupRegistered) {
+    qAddPostRoutine(clearSymbolCache);
+    cacheCleanupRegistered = true;
+  }
   initializeSymbolList();
   const int colorCount = colors_.size();
   const int characterCount = unicodeCharacters_.size();
@@ -61,9 +72,67 @@ symbolChooser::symbolChooser(int symbolDimension, const QVector<triC>& colors,
   colorIndex_ = stepIndex(0, numberOfSymbols(), 1);
   // it's possible these symbols will never get used with the default values, but
   // we still need to establish the color-->symbol correspondence here
+  if (!QFontDatabase::supportsThreadedFontRendering()) {
+    for (int i = 0, size = colors_.size(); i < size; ++i) {
+      createNewSymbolCurDims(colors_[i].qrgb());
+    }
+    return;
+  }
+  // Assign the indices now (in color order, so that the correspondence is
+  // the same as always), but render the symbols in parallel; they're
+  // turned into pixmaps by collectPendingSymbols the first time they're
+  // needed.
+  QVector<symbolRenderJob> jobs;
+  jobs.reserve(colors_.size());
   for (int i = 0, size = colors_.size(); i < size; ++i) {
-    createNewSymbolCurDims(colors_[i].qrgb());
+    const QRgb thisColor = colors_[i].qrgb();
+    const int newIndex = getNewIndex();
+    symbolMap_.insert(thisColor,
+                      patternSymbolIndex(QPixmap(), newIndex,
+                                         borderDimension_,
+                                         symbolDimension_));
+    jobs.push_back(symbolRenderJob(newIndex, thisColor, symbolDimension_,
+                                   borderDimension_, numberOfSymbols()));
+  }
+  pendingColors_.reserve(jobs.size());
+  for (int i = 0, size = jobs.size(); i < size; ++i) {
+    pendingColors_.push_back(jobs[i].color);
+  }
+  pendingSymbols_ = QtConcurrent::mapped(jobs, &symbolChooser::renderSymbolJob);
+}
+
+symbolChooser::~symbolChooser() {
+
+  // (jobs in progress only use their own copy of the job data)
+  pendingSymbols_.cancel();
+}
+
+void symbolChooser::collectPendingSymbols() {
+
+  if (pendingColors_.isEmpty()) {
+    return;
   }
+  pendingSymbols_.waitForFinished();
+  for (int i = 0, size = pendingColors_.size(); i < size; ++i) {
+    const QRgb thisColor = pendingColors_[i];
+    const patternSymbolIndex oldIndex = symbolMap_.value(thisColor);
+    const QPixmap symbol = QPixmap::fromImage(pendingSymbols_.resultAt(i));
+    const int dimension = oldIndex.symbolDimension();
+    const int borderWidth = oldIndex.borderWidth();
+    symbolCache_.insert(cacheKey(oldIndex.index(), thisColor, dimension,
+                                 borderWidth),
+                        new QPixmap(symbol), dimension * dimension);
+    symbolMap_.insert(thisColor,
+                      patternSymbolIndex(symbol, oldIndex.index(),
+                                         borderWidth, dimension));
+  }
+  pendingColors_.clear();
+  pendingSymbols_ = QFuture<QImage>();
+}
+
+bool symbolChooser::symbolsPending() const {
+
+  return !pendingColors_.isEmpty() && !pendingSymbols_.isFinished();
 }
 
 void symbolChooser::setSymbolDimension(int dimension) {
@@ -76,6 +145,7 @@ void symbolChooser::setSymbolDimension(int dimension) {
 patternSymbolIndex symbolChooser::getSymbol(const triC& color,
                                             int symbolDim) {
 
+  collectPendingSymbols();
   const QRgb rgbColor = color.qrgb();
   symbolDimension_ = symbolDim;
   if (symbolMap_.contains(rgbColor)) {
@@ -85,7 +155,7 @@ patternSymbolIndex symbolChooser::getSymbol(const triC& color,
     }
     else { // right symbol, wrong size
       const int index = symbolMap_[rgbColor].index();
-      patternSymbolIndex symbolIndex(createSymbol(index, rgbColor),
+      patternSymbolIndex symbolIndex(cachedSymbol(index, rgbColor),
                                      index, borderDimension_,
                                      symbolDimension_);
       symbolMap_.insert(rgbColor, symbolIndex);
@@ -100,7 +170,7 @@ patternSymbolIndex symbolChooser::getSymbol(const triC& color,
 patternSymbolIndex symbolChooser::createNewSymbolCurDims(QRgb color) {
 
   const int newIndex = getNewIndex();
-  const patternSymbolIndex symbolIndex(createSymbol(newIndex, color),
+  const patternSymbolIndex symbolIndex(cachedSymbol(newIndex, color),
                                        newIndex, borderDimension_,
                                        symbolDimension_);
   symbolMap_.insert(color, symbolIndex);
@@ -118,12 +188,85 @@ QHash<QRgb, QPixmap> symbolChooser::getSymbols(int symbolDim) {
   return returnMap;
 }
 
+void symbolChooser::cacheSymbols(int symbolDim) {
+
+  collectPendingSymbols();
+  const int savedSymbolDim = symbolDimension_;
+  symbolDimension_ = symbolDim;
+  for (QHash<QRgb, patternSymbolIndex>::const_iterator it = symbolMap_.begin(),
+         end = symbolMap_.end(); it != end; ++it) {
+    cachedSymbol(it.value().index(), it.key());
+  }
+  symbolDimension_ = savedSymbolDim;
+}
+
+symbolChooser::symbolKey symbolChooser::cacheKey(int index, QRgb color,
+                                                 int symbolDim,
+                                                 int borderDim) const {
+
+  const bool isColorSquare = index >= numberOfSymbols();
+  // the background color only shows if there's a border or no symbol
+  const QRgb keyColor = (borderDim || isColorSquare) ? color : 0;
+  return symbolKey(isColorSquare ? -1 : index, symbolDim, borderDim,
+                   keyColor);
+}
+
+QPixmap symbolChooser::cachedSymbol(int index, const triC& color) const {
+
+  const symbolKey key = cacheKey(index, color.qrgb(), symbolDimension_,
+                                 borderDimension_);
+  const QPixmap* cachedPixmap = symbolCache_.object(key);
+  if (cachedPixmap) {
+    return *cachedPixmap;
+  }
+  const QPixmap symbol = createSymbol(index, color);
+  symbolCache_.insert(key, new QPixmap(symbol),
+                      symbolDimension_ * symbolDimension_);
+  return symbol;
+}
+
+qint64 symbolChooser::symbolBytes() const {
+
+  qint64 bytes = 0;
+  for (QHash<QRgb, patternSymbolIndex>::const_iterator it =
+         symbolMap_.begin(), end = symbolMap_.end(); it != end; ++it) {
+    bytes += memoryUsage::pixmapBytes(it.value().symbol());
+  }
+  return bytes;
+}
+
+qint64 symbolChooser::cacheBytes() {
+
+  // the cache cost is the pixel count
+  return static_cast<qint64>(symbolCache_.totalCost()) * sizeof(QRgb);
+}
+
+void symbolChooser::clearSymbolCache() {
+
+  symbolCache_.clear();
+}
+
 QPixmap symbolChooser::createSymbol(int index, const triC& color) const {
 
-  const int drawDimension = symbolDimension_ - 2 * borderDimension_;
-  QPixmap drawSymbol(drawDimension, drawDimension);
+  return QPixmap::fromImage(renderSymbol(index, color, symbolDimension_,
+                                         borderDimension_,
+                                         numberOfSymbols()));
+}
+
+QImage symbolChooser::renderSymbolJob(const symbolRenderJob& job) {
+
+  return renderSymbol(job.index, job.color, job.symbolDim, job.borderDim,
+                      job.symbolCount);
+}
+
+QImage symbolChooser::renderSymbol(int index, const triC& color,
+                                   int symbolDim, int borderDim,
+                                   int symbolCount) {
+
+  const int drawDimension = symbolDim - 2 * borderDim;
+  QImage drawSymbol(drawDimension, drawDimension, QImage::Format_RGB32);
   drawSymbol.fill(Qt::white);
-  if (index < numberOfSymbols()) {
+  if (index < symbolCount) {
     QPainter painter(&drawSymbol);
     painter.setRenderHint(QPainter::Antialiasing, true);
     const int interval = unicodeCharacters_.size();
@@ -155,13 +298,12 @@ QPixmap symbolChooser::createSymbol(int index, const triC& color) const {
     painter.fillRect(0, 0, drawDimension, drawDimension, color.qc());
   }
 
-  if (borderDimension_) {
-    QPixmap newSymbol(symbolDimension_, symbolDimension_);
+  if (borderDim) {
+    QImage newSymbol(symbolDim, symbolDim, QImage::Format_RGB32);
     newSymbol.fill(color.qrgb());
     QPainter painter(&newSymbol);
     painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.drawPixmap(QPoint(borderDimension_, borderDimension_),
-                       drawSymbol);
+    painter.drawImage(QPoint(borderDim, borderDim), drawSymbol);
     return newSymbol;
   }
   else {
@@ -171,7 +313,7 @@ QPixmap symbolChooser::createSymbol(int index, const triC& color) const {
 
 // circle
 void symbolChooser::createSymbolType2(QPainter* painter,
-                                      int drawDimension) const {
+                                      int drawDimension) {
 
   painter->save();
   painter->drawEllipse(0, 0, drawDimension, drawDimension);
@@ -180,7 +322,7 @@ void symbolChooser::createSymbolType2(QPainter* painter,
 
 // NW and SE diagonals
 void symbolChooser::createSymbolType3(QPainter* painter,
-                                      int drawDimension) const {
+                                      int drawDimension) {
 
   const qreal d1 = static_cast<qreal>(drawDimension)/3;
   const qreal d2 = drawDimension - d1;
@@ -191,7 +333,7 @@ void symbolChooser::createSymbolType3(QPainter* painter,
 
 // NE and SW diagonals
 void symbolChooser::createSymbolType4(QPainter* painter,
-                                      int drawDimension) const {
+                                      int drawDimension) {
 
   const qreal d1 = static_cast<qreal>(drawDimension)/3;
   const qreal d2 = drawDimension - d1;
@@ -203,13 +345,14 @@ void symbolChooser::createSymbolType4(QPainter* painter,
 QVector<patternSymbolIndex> symbolChooser::
 symbolsAvailable(const triC& color, int symbolDim) {
 
+  collectPendingSymbols();
   symbolDimension_ = symbolDim;
   QVector<patternSymbolIndex> availableSymbols;
   const QRgb rgbColor = color.qrgb();
   const QList<int> availableIndices = colorIndex_.availableIndices();
   for (QList<int>::const_iterator it = availableIndices.begin(),
          end = availableIndices.end(); it != end; ++it) {
-    availableSymbols.push_back(patternSymbolIndex(createSymbol(*it,
+    availableSymbols.push_back(patternSymbolIndex(cachedSymbol(*it,
                                                                rgbColor),
                                                   *it, borderDimension_,
                                                   symbolDimension_));
@@ -219,6 +362,7 @@ symbolsAvailable(const triC& color, int symbolDim) {
 
 bool symbolChooser::changeSymbol(const triC& color, int newIndex) {
 
+  collectPendingSymbols();
   const QRgb rgbColor = color.qrgb();
   const QHash<QRgb, patternSymbolIndex>::const_iterator it =
     symbolMap_.find(rgbColor);
@@ -236,7 +380,7 @@ bool symbolChooser::changeSymbol(const triC& color, int newIndex) {
     symbolMap_.remove(rgbColor);
     colorIndex_.reserve(newIndex);
     symbolMap_.insert(rgbColor,
-                      patternSymbolIndex(createSymbol(newIndex, rgbColor),
+                      patternSymbolIndex(cachedSymbol(newIndex, rgbColor),
                                          newIndex, borderDimension_,
                                          symbolDimension_));
     return true;
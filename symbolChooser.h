@@ -21,6 +21,9 @@
 #define SYMBOLCHOOSER_H
 
 #include <QFont>
+#include <QImage>
+#include <QtCore/QCache>
+#include <QtCore/QFuture>
 
 #include "triC.h"
 #include "stepIndex.h"
@@ -68,6 +71,18 @@ extern const int MAX_NUM_SYMBOL_TYPES;
 // multiple combinations of size/border stored in the symbol map at
 // any given time.
 //
+// Rendered symbols are also kept in symbolCache_, which is shared by all
+// symbolChoosers (the symbol font is static) and keyed by symbol index,
+// size and border (plus background color where that matters), so that
+// switching back and forth between screen, export and pdf sizes doesn't
+// re-render symbols we've already drawn.  The cache is bounded by total
+// pixel count; least recently used symbols are dropped first.
+//
+// The initial symbols for all colors are rendered concurrently at
+// construction (into QImages, since QPixmaps can only be used on the GUI
+// thread); the results are converted to pixmaps by collectPendingSymbols
+// the first time any symbol is requested.
+//
 class symbolChooser {
 
  public:
@@ -76,6 +91,7 @@ class symbolChooser {
   // create symbols for
   symbolChooser(int symbolDimension, const QVector<triC>& colors,
                 int borderDim = 4);
+  ~symbolChooser();
   // run through a predefined list of unicode characters to determine
   // which are defined in the current system font and save the list to
   // unicodeCharacters_
@@ -141,6 +157,17 @@ class symbolChooser {
   }
   // return a sample symbol of size <symbolSize> using the symbol font
   static QPixmap getSampleSymbol(int symbolSize);
+  // render (if necessary) all of our symbols with total size <symbolDim>
+  // and the current borderDimension_ into the symbol cache, without
+  // changing the current symbol dimension or symbolMap_
+  void cacheSymbols(int symbolDim);
+  // true if the initial symbols are still being rendered
+  bool symbolsPending() const;
+  // the memory held by the symbols currently assigned to our colors
+  // (which may also be held by the symbol cache)
+  qint64 symbolBytes() const;
+  // the memory held by the symbol cache shared by all symbolChoosers
+  static qint64 cacheBytes();
 
  private:
   // return the next available index;
@@ -148,16 +175,32 @@ class symbolChooser {
   int getNewIndex() { return colorIndex_.next(); }
   // MUST only be called if <color> has not yet been assigned a symbol
   patternSymbolIndex createNewSymbolCurDims(QRgb color);
+  // return the symbol for index <index> using the current symbolDim and
+  // borderDim and background <color>, from symbolCache_ if it's there,
+  // otherwise create it and add it to the cache; doesn't update symbolMap_
+  QPixmap cachedSymbol(int index, const triC& color) const;
+  // drop all cached symbols (called on application exit, since pixmaps
+  // can't outlive the application)
+  static void clearSymbolCache();
   // create and return the symbol for index <index> using the current
   // symbolDim and borderDim and <color> for the background if there's a
   // border; doesn't update symbolMap_
   QPixmap createSymbol(int index,
                        const triC& color = triC(255, 255, 255)) const;
+  // render the symbol for <index> with total size <symbolDim>, border
+  // <borderDim> and background <color>, where <symbolCount> is the number
+  // of symbols in play; safe to call from any thread once the symbol list
+  // has been initialized
+  static QImage renderSymbol(int index, const triC& color, int symbolDim,
+                             int borderDim, int symbolCount);
+  // wait for any symbols still being rendered from construction and
+  // move them into symbolMap_ and the symbol cache as pixmaps
+  void collectPendingSymbols();
   // draw the background pixmap for the different types of symbols
   // (type1 is "plain")
-  void createSymbolType2(QPainter* painter, int drawDim) const;
-  void createSymbolType3(QPainter* painter, int drawDim) const;
-  void createSymbolType4(QPainter* painter, int drawDim) const;
+  static void createSymbolType2(QPainter* painter, int drawDim);
+  static void createSymbolType3(QPainter* painter, int drawDim);
+  static void createSymbolType4(QPainter* painter, int drawDim);
   // return the total number of possible symbols
   int numberOfSymbols() const {
     return unicodeCharacters_.size() * numSymbolTypes_;
@@ -174,7 +217,7 @@ class symbolChooser {
       pointSize_ = f.pointSize();
       weight_ = f.weight();
     }
-    QFont qFont() {
+    QFont qFont() const {
       return QFont(family_, pointSize_, weight_, false);
     }
 
@@ -183,18 +226,64 @@ class symbolChooser {
     int pointSize_;
     int weight_;
   };
+  // symbolCache_ key: a symbol is determined by its index, its total
+  // dimension and its border width, and by its background color if it
+  // has a border or is a plain color square (index -1)
+  class symbolKey {
+   public:
+    symbolKey(int index, int dimension, int borderWidth, QRgb color)
+      : index_(index), dimension_(dimension), borderWidth_(borderWidth),
+        color_(color) {}
+    bool operator==(const symbolKey& other) const {
+      return index_ == other.index_ && dimension_ == other.dimension_ &&
+        borderWidth_ == other.borderWidth_ && color_ == other.color_;
+    }
+    friend uint qHash(const symbolKey& key) {
+      return qHash(key.color_) ^ (key.index_ << 16) ^
+        (key.dimension_ << 4) ^ key.borderWidth_;
+    }
+   private:
+    int index_;
+    int dimension_;
+    int borderWidth_;
+    QRgb color_;
+  };
+  // return the symbolCache_ key for the given symbol
+  symbolKey cacheKey(int index, QRgb color, int symbolDim,
+                     int borderDim) const;
+  // everything needed to render one symbol off the GUI thread
+  class symbolRenderJob {
+   public:
+    symbolRenderJob() : index(0), color(0), symbolDim(0), borderDim(0),
+      symbolCount(0) {}
+    symbolRenderJob(int i, QRgb c, int dim, int border, int count)
+      : index(i), color(c), symbolDim(dim), borderDim(border),
+        symbolCount(count) {}
+    int index;
+    QRgb color;
+    int symbolDim;
+    int borderDim;
+    int symbolCount;
+  };
+  static QImage renderSymbolJob(const symbolRenderJob& job);
 
  private:
   // the unicode characters to be used as symbols
   static QVector<QChar> unicodeCharacters_;
   // the font we're using for symbols (chosen for max # of symbols)
   static cheapFont unicodeFont_;
+  // rendered symbols shared by all symbolChoosers; cost is pixel count
+  static QCache<symbolKey, QPixmap> symbolCache_;
   // the total number of symbol types we're using (with light and dark
   // types counted separately)
   int numSymbolTypes_;
   QVector<triC> colors_;
   // the most recently created symbols for the hash's color keys
   QHash<QRgb, patternSymbolIndex> symbolMap_;
+  // symbols rendering concurrently from construction; the nth result is
+  // the symbol for pendingColors_[n] (empty once they've been collected)
+  QFuture<QImage> pendingSymbols_;
+  QVector<QRgb> pendingColors_;
   stepIndex colorIndex_; // available symbol indices
   int symbolDimension_; // size of the symbols (with border)
   // size of a border around the symbol (0 means no border)
@@ -0,0 +1,166 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include "trace.h"
+
+#include <QtCore/QAtomicInteger>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+#include <QtCore/QVector>
+
+QAtomicInt tracer::on_;
+
+// one recorded span
+class traceEvent {
+ public:
+  traceEvent() : name_(NULL), start_(0), end_(0), thread_(0) {}
+  traceEvent(const char* name, qint64 start, qint64 end, int thread)
+    : name_(name), start_(start), end_(end), thread_(thread) {}
+  QJsonObject toJson() const;
+
+ private:
+  const char* name_;
+  qint64 start_; // nanoseconds
+  qint64 end_; // nanoseconds
+  int thread_; // our thread number
+};
+
+QJsonObject traceEvent::toJson() const {
+
+  // trace event times are in (fractional) microseconds
+  QJsonObject object;
+  object["name"] = QString(name_);
+  object["ph"] = QString("X");
+  object["ts"] = start_/1000.;
+  object["dur"] = (end_ - start_)/1000.;
+  object["pid"] = 1;
+  object["tid"] = thread_;
+  return object;
+}
+
+// return a started timer
+static QElapsedTimer startedTimer() {
+
+  QElapsedTimer timer;
+  timer.start();
+  return timer;
+}
+
+// the monotonic clock span times are read from; it's never restarted, so
+// any thread can read it (and a function static's initialization is
+// thread safe)
+static const QElapsedTimer& traceClock() {
+
+  static const QElapsedTimer clock = startedTimer();
+  return clock;
+}
+
+// the traceClock time tracing was last started at
+static QAtomicInteger<qint64> traceEpoch;
+// the recording state, guarded by traceMutex
+static QMutex traceMutex;
+static QString traceFileName;
+static QVector<traceEvent> traceEvents;
+// keys are thread handles, values are our (small) numbers for them
+static QHash<Qt::HANDLE, int> traceThreads;
+
+void tracer::start(const QString& fileName) {
+
+  QMutexLocker locker(&traceMutex);
+  traceFileName = fileName;
+  traceEvents.clear();
+  traceThreads.clear();
+  traceEpoch.storeRelease(traceClock().nsecsElapsed());
+  on_.store(1);
+}
+
+QString tracer::fileName() {
+
+  QMutexLocker locker(&traceMutex);
+  return traceFileName;
+}
+
+qint64 tracer::now() {
+
+  return traceClock().nsecsElapsed();
+}
+
+void tracer::record(const char* name, qint64 start, qint64 end) {
+
+  QMutexLocker locker(&traceMutex);
+  if (!on()) { // tracing stopped after the span started
+    return;
+  }
+  const qint64 epoch = traceEpoch.loadAcquire();
+  if (start < epoch) { // the span started before this trace did
+    return;
+  }
+  const Qt::HANDLE thread = QThread::currentThreadId();
+  QHash<Qt::HANDLE, int>::const_iterator found = traceThreads.find(thread);
+  if (found == traceThreads.end()) {
+    found = traceThreads.insert(thread, traceThreads.size() + 1);
+  }
+  traceEvents.push_back(traceEvent(name, start - epoch, end - epoch,
+                                  found.value()));
+}
+
+bool tracer::stop() {
+
+  QMutexLocker locker(&traceMutex);
+  if (!on()) {
+    return true;
+  }
+  on_.store(0);
+
+  QJsonArray events;
+  // name the threads (stop is only called from the gui thread)
+  const Qt::HANDLE guiThread = QThread::currentThreadId();
+  for (QHash<Qt::HANDLE, int>::const_iterator it = traceThreads.begin(),
+         end = traceThreads.end(); it != end; ++it) {
+    QJsonObject args;
+    args["name"] = it.key() == guiThread ? QString("gui") :
+      QString("worker %1").arg(it.value());
+    QJsonObject object;
+    object["name"] = QString("thread_name");
+    object["ph"] = QString("M");
+    object["pid"] = 1;
+    object["tid"] = it.value();
+    object["args"] = args;
+    events.append(object);
+  }
+  for (int i = 0, size = traceEvents.size(); i < size; ++i) {
+    events.append(traceEvents[i].toJson());
+  }
+  traceEvents.clear();
+  traceThreads.clear();
+
+  QJsonObject root;
+  root["traceEvents"] = events;
+  root["displayTimeUnit"] = QString("ns");
+  QFile file(traceFileName);
+  return file.open(QIODevice::WriteOnly) &&
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) != -1;
+}
@@ -0,0 +1,86 @@
+//
+// Copyright 2010, 2011 Tom Klein.
+//
+// This file is part of cstitch.
+//
+// cstitch is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QString>
+
+// tracer collects timed spans (see traceSpan) while tracing is on and
+// writes them out as a Chrome trace event json file (viewable in
+// chrome://tracing or Perfetto) when tracing is turned off.
+// Tracing is turned on at startup if the CSTITCH_TRACE environment
+// variable names a file, or from the help menu.
+// All methods except stop may be called from any thread; stop must be
+// called from the gui thread.
+class tracer {
+
+ public:
+  static bool on() { return on_.load() != 0; }
+  // start recording spans, to be written to <fileName>
+  static void start(const QString& fileName);
+  // stop recording spans and write the ones recorded since start to the
+  // start file; return false if the file couldn't be written
+  static bool stop();
+  // the file the current trace will be written to
+  static QString fileName();
+  // the current time in nanoseconds on a monotonic clock
+  static qint64 now();
+  // record a span <name> from <start> to <end> (times from now()) on the
+  // current thread; spans that started before tracing was last started
+  // are dropped
+  // <name> must stay valid until tracing stops (use a string literal)
+  static void record(const char* name, qint64 start, qint64 end);
+
+ private:
+  static QAtomicInt on_;
+};
+
+// traceSpan records the time from its construction to its destruction
+// (or to restart) under <name> if tracing is on when it's constructed.
+// <name> must be a string literal.
+class traceSpan {
+
+ public:
+  explicit traceSpan(const char* name)
+    : name_(name), start_(tracer::on() ? tracer::now() : -1) {}
+  ~traceSpan() { finish(); }
+  // finish the current span and start a new one named <name>
+  void restart(const char* name) {
+    finish();
+    name_ = name;
+    start_ = tracer::on() ? tracer::now() : -1;
+  }
+
+ private:
+  void finish() {
+    if (start_ >= 0) {
+      tracer::record(name_, start_, tracer::now());
+      start_ = -1;
+    }
+  }
+  Q_DISABLE_COPY(traceSpan)
+
+ private:
+  const char* name_;
+  qint64 start_; // -1 if we're not recording
+};
+
+#endif
@@ -20,8 +20,10 @@
 #include "utility.h"
 
 #include <QtCore/qmath.h>
+#include <QtCore/QCoreApplication>
 #include <QtCore/QFile>
 #include <QtCore/QTextStream>
+#include <QtCore/QThread>
 
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QFileDialog>
@@ -32,6 +34,7 @@ extern const int PROGRESS_X_COORDINATE;
 extern const int PROGRESS_Y_COORDINATE;
 
 groupProgressDialog* altMeter::groupDialog_ = NULL;
+QAtomicInt altMeter::backgroundCanceled_(0);
 
 QString getNewImageFileName(QWidget* activeWindow, bool displayWarning) {
 
@@ -86,7 +89,10 @@ groupProgressDialog::groupProgressDialog(int numDialogs)
 altMeter::altMeter(const QString& labelText, const QString& cancelButtonText,
                    int minimum, int maximum) {
 
-  if (!groupDialog_) {
+  if (QThread::currentThread() != QCoreApplication::instance()->thread()) {
+    dialog_ = NULL;
+  }
+  else if (!groupDialog_) {
     dialog_ = new QProgressDialog;
     dialog_->setLabelText(labelText);
     dialog_->setCancelButtonText(cancelButtonText);
@@ -23,6 +23,7 @@
 #include <algorithm>
 
 #include <QtCore/QAbstractEventDispatcher>
+#include <QtCore/QAtomicInt>
 #include <QtWidgets/QAction>
 #include <QtWidgets/QProgressDialog>
 #include <QCloseEvent>
@@ -181,32 +182,51 @@ class groupProgressDialog : public QProgressDialog {
 
 // see documentation above for groupProgressDialog on the interaction
 // between that class and this.
+// An altMeter constructed off of the gui thread (for background
+// processing) doesn't display anything, and reports that it was canceled
+// once setBackgroundCanceled(true) has been called.
 // setGroupMeter MUST NOT be called while any altMeter is active
 class altMeter {
  public:
   altMeter(const QString& labelText, const QString& cancelButtonText,
            int minimum, int maximum);
   ~altMeter() {
-    if (!groupDialog_) {
+    if (dialog_ != groupDialog_) {
       delete dialog_;
     }
   }
-  void setMinimumDuration(int min) { dialog_->setMinimumDuration(min); }
-  bool wasCanceled() const { return dialog_->wasCanceled(); }
+  void setMinimumDuration(int min) {
+    if (dialog_) {
+      dialog_->setMinimumDuration(min);
+    }
+  }
+  bool wasCanceled() const {
+    return dialog_ ? dialog_->wasCanceled() :
+      backgroundCanceled_.load() != 0;
+  }
   void setValue(int value) {
-    dialog_->setValue(value);
+    if (dialog_) {
+      dialog_->setValue(value);
+    }
   }
   void show() {
-    dialog_->show();
+    if (dialog_) {
+      dialog_->show();
+    }
   }
   // MUST NOT be called while any altMeter is active
   static void setGroupMeter(groupProgressDialog* meter) {
     groupDialog_ = meter;
   }
+  // cancel (or allow) all background meters
+  static void setBackgroundCanceled(bool canceled) {
+    backgroundCanceled_.store(canceled ? 1 : 0);
+  }
 
  private:
   QProgressDialog* dialog_;
   static groupProgressDialog* groupDialog_;
+  static QAtomicInt backgroundCanceled_;
 };
 
 #endif
@@ -19,22 +19,35 @@
 
 #include "windowManager.h"
 
+#include <QtCore/QBuffer>
+#include <QtCore/QDir>
 #include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
 #include <QtCore/QSettings>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QTextStream>
 #include <QtCore/QDateTime>
+#include <QtCore/QXmlStreamReader>
 #include <QtConcurrent/QtConcurrentRun>
 
 #include <QtWidgets/QMenu>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
+#include <QImageReader>
 #include <QImageWriter>
 
+#include "benchmark.h"
 #include "colorChooser.h"
 #include "colorCompare.h"
 #include "fileListMenu.h"
+#include "flossPalette.h"
 #include "imageUtility.h"
+#include "kernelCheck.h"
+#include "memoryUsage.h"
+#include "trace.h"
 #include "patternWindow.h"
 #include "squareWindow.h"
+#include "symbolChooser.h"
 #include "versionProcessing.h"
 #include "xmlUtility.h"
 
@@ -129,6 +142,21 @@ windowManager::windowManager() : originalImageColorCount_(0),
   // else quickHelp will be called on a non-existent active window!
   connect(autoShowQuickHelp_, SIGNAL(toggled(bool )),
           this, SLOT(autoShowQuickHelp(bool )));
+
+  // CSTITCH_TRACE=<file> records a timing trace from startup
+  recordTraceAction_ = new QAction(tr("Record timing trace..."), this);
+  recordTraceAction_->setCheckable(true);
+  const QString traceFile = QString::fromLocal8Bit(qgetenv("CSTITCH_TRACE"));
+  if (!traceFile.isEmpty()) {
+    tracer::start(traceFile);
+    recordTraceAction_->setChecked(true);
+  }
+  connect(recordTraceAction_, SIGNAL(toggled(bool )),
+          this, SLOT(recordTrace(bool )));
+
+  memoryUsageAction_ = new QAction(tr("Memory usage"), this);
+  connect(memoryUsageAction_, SIGNAL(triggered()),
+          this, SLOT(showMemoryUsage()));
 }
 
 void windowManager::configureNewWindow(imageZoomWindow* window,
@@ -151,6 +179,8 @@ void windowManager::configureNewWindow(imageZoomWindow* window,
   window->setWindowTitle(getWindowTitle());
   window->setWindowIcon(QIcon(":cstitch.png"));
   window->addQuickHelp(autoShowQuickHelp_);
+  window->addRecordTrace(recordTraceAction_);
+  window->addMemoryUsage(memoryUsageAction_);
   window->showQuickHelp(false); // close any current quick help
   if (!hideWindows_) {
     window->showQuickHelp(autoShowQuickHelp_->isChecked());
@@ -358,7 +388,17 @@ static void reportMissingChild(const QString& parentContext, int parent,
                         .arg(child).arg(childContext));
 }
 
-void windowManager::saveAs(const QString projectFilename) {
+// return <image> encoded as a png
+static QByteArray pngData(const QImage& image) {
+
+  QByteArray imageData;
+  QBuffer imageBuffer(&imageData);
+  imageBuffer.open(QIODevice::WriteOnly);
+  image.save(&imageBuffer, "PNG");
+  return imageData;
+}
+
+bool windowManager::saveAs(const QString projectFilename) {
 
   if (projectFilename.isNull()) {
     const QString fileString =
@@ -369,28 +409,54 @@ void windowManager::saveAs(const QString projectFilename) {
       projectFilename_ = fileString;
     }
     else {
-      return;
+      return false;
     }
   }
 
-  QDomDocument doc;
-  QDomElement root = doc.createElement("cstitch");
+  const traceSpan span("windowManager::saveAs");
+  // the original image data may come from the file we're about to
+  // overwrite, or its file may have changed since we loaded it
+  traceSpan step("saveAs: check image data");
+  const QFileInfo projectInfo(projectFilename_);
+  if (projectInfo.exists() &&
+      projectInfo.canonicalFilePath() == originalImageData_.fileName()) {
+    originalImageData_.detach();
+  }
+  if (!originalImageData_.available()) {
+    // fall back to the decoded image
+    originalImageData_.setData(::pngData(originalImage_));
+  }
+
+  // the xml is streamed straight to the file (history lists can be large,
+  // so we don't want to build a document in memory first); QSaveFile only
+  // replaces an existing project once everything has been written
+  step.restart("saveAs: write xml");
+  QSaveFile outFile(projectFilename_);
+  if (!outFile.open(QIODevice::WriteOnly)) {
+    QMessageBox::critical(activeWindow(), tr("Save failed"),
+                          tr("Sorry, %1 couldn't be opened for writing (%2), "
+                             "so the project wasn't saved.")
+                          .arg(projectFilename_).arg(outFile.errorString()));
+    return false;
+  }
+  // (xmlWriter writes the same bytes the QDomDocument we used to build
+  // here did; in particular there's no xml declaration, so the root tag
+  // starts the first line, which openProject checks)
+  xmlWriter writer(&outFile);
+  writer.writeStartElement("cstitch");
   // version
-  root.setAttribute("version", projectVersion_);
-  doc.appendChild(root);
-  ::appendTextElement(&doc, "warning",
-                      tr("DIRE WARNING: DO NOT EDIT THIS FILE BY HAND! ! ! ! ! ! ! ! ! ! ! ! ! ! !"),
-                      &root);
-  ::appendTextElement(&doc, "warning",
-                      "DIRE WARNING: DO NOT EDIT THIS FILE BY HAND! ! ! ! ! ! ! ! ! ! ! ! ! ! !",
-                      &root);
+  writer.writeAttribute("version", projectVersion_);
+  writer.writeTextElement("warning",
+                          tr("DIRE WARNING: DO NOT EDIT THIS FILE BY HAND! ! ! ! ! ! ! ! ! ! ! ! ! ! !"));
+  writer.writeTextElement("warning",
+                          "DIRE WARNING: DO NOT EDIT THIS FILE BY HAND! ! ! ! ! ! ! ! ! ! ! ! ! ! !");
   // date
-  ::appendTextElement(&doc, "date", QDateTime::currentDateTime().toString(),
-                      &root);
+  writer.writeTextElement("date", QDateTime::currentDateTime().toString());
   // image color count
-  ::appendTextElement(&doc, "color_count",
-                      ::itoqs(getOriginalImageColorCount()), &root);
+  writer.writeTextElement("color_count",
+                          ::itoqs(getOriginalImageColorCount()));
   // first write settings that are independent of any particular image
+  QDomDocument doc;
   QDomElement globals(doc.createElement("global_settings"));
   // a disabled window is one that doesn't have any images other than the
   // original (and is therefore not currently being displayed)
@@ -406,21 +472,21 @@ void windowManager::saveAs(const QString projectFilename) {
   if (patternWindowAction_->isEnabled() && patternWindow_.window()) {
     patternWindow_.window()->appendCurrentSettings(&doc, &globals);
   }
+  ::writeDomElement(&writer, globals);
 
-  root.appendChild(globals);
+  // false if some edit history couldn't be read back from disk
+  bool historyWritten = true;
   //// colorCompare
   if (!colorCompareSavers_.empty()) {
-    QDomElement colorCompareElement = doc.createElement("color_compare");
-    root.appendChild(colorCompareElement);
+    writer.writeStartElement("color_compare");
     for (int i = 0, size = colorCompareSavers_.size(); i < size; ++i) {
       const colorCompareSaver thisColorCompareSaver = colorCompareSavers_[i];
-      QDomElement thisColorCompareImage(thisColorCompareSaver.toXml(&doc));
-      colorCompareElement.appendChild(thisColorCompareImage);
+      historyWritten = thisColorCompareSaver.startXml(&writer) &&
+        historyWritten;
       if (thisColorCompareSaver.hasChildren()) {
         //// squareWindow
         squareWindow* squareWindowObject = squareWindow_.window();
-        QDomElement squareWindowElement = doc.createElement("square_window");
-        thisColorCompareImage.appendChild(squareWindowElement);
+        writer.writeStartElement("square_window");
         const QList<int> colorCompareChildren =
           thisColorCompareSaver.children();
         for (int ii = 0, iiSize = colorCompareChildren.size();
@@ -433,19 +499,19 @@ void windowManager::saveAs(const QString projectFilename) {
                                "square", thisCompareChild);
             continue;
           }
-          QDomElement thisSquareXml = thisSquareWindowSaver.toXml(&doc);
-          squareWindowElement.appendChild(thisSquareXml);
+          historyWritten = thisSquareWindowSaver.startXml(&writer) &&
+            historyWritten;
           if (!thisSquareWindowSaver.hidden()) {
-            // append the current history for this child
-            squareWindowObject->writeCurrentHistory(&doc, &thisSquareXml,
-                                                    thisCompareChild);
+            // write the current history for this child
+            historyWritten =
+              squareWindowObject->writeCurrentHistory(&writer,
+                                                      thisCompareChild) &&
+              historyWritten;
           }
           if (thisSquareWindowSaver.hasChildren()) {
             //// patternWindow
             patternWindow* patternWindowObject = patternWindow_.window();
-            QDomElement patternWindowElement =
-              doc.createElement("pattern_window");
-            thisSquareXml.appendChild(patternWindowElement);
+            writer.writeStartElement("pattern_window");
             const QList<int> squareWindowChildren =
               thisSquareWindowSaver.children();
             for (int iii = 0, iiiSize = squareWindowChildren.size();
@@ -458,36 +524,83 @@ void windowManager::saveAs(const QString projectFilename) {
                                    "pattern", thisSquareChild);
                 continue;
               }
-              QDomElement thisPatternXml = thisPatternWindowSaver.toXml(&doc);
-              patternWindowElement.appendChild(thisPatternXml);
-              // append the history for this child
-              patternWindowObject->writeCurrentHistory(&doc, &thisPatternXml,
+              historyWritten = thisPatternWindowSaver.startXml(&writer) &&
+                historyWritten;
+              // write the history for this child
+              patternWindowObject->writeCurrentHistory(&writer,
                                                        thisSquareChild);
+              writer.writeEndElement(); // pattern_window_image
             }
+            writer.writeEndElement(); // pattern_window
           }
+          writer.writeEndElement(); // square_window_image
         }
+        writer.writeEndElement(); // square_window
       }
+      writer.writeEndElement(); // color_compare_image
     }
+    writer.writeEndElement(); // color_compare
+  }
+  // (ending the root element ends the last line, and then there's a blank
+  // line between the xml and the image)
+  writer.writeEndDocument();
+  outFile.write("\n");
+  if (!historyWritten) {
+    outFile.cancelWriting();
+    QMessageBox::critical(activeWindow(), tr("Save failed"),
+                          tr("Sorry, some of the edit history couldn't be "
+                             "read back from disk, so the project wasn't "
+                             "saved (%1 hasn't been changed).")
+                          .arg(projectFilename_));
+    return false;
   }
-  QString xmlString = doc.toString(2);
-
-  // write the xml portion as text
-  QFile outFile(projectFilename_);
-  outFile.open(QIODevice::WriteOnly);
-  QTextStream textStream(&outFile);
-  textStream << xmlString << endl;
-  textStream.flush();
-  outFile.close();
 
-  // append the image as binary
-  outFile.open(QIODevice::Append);
+  // append the image as binary (in QByteArray's stream format)
+  step.restart("saveAs: write image");
+  const qint64 headerOffset = outFile.pos();
   QDataStream dataStream(&outFile);
-  dataStream << originalImageData_;
-  outFile.close();
+  dataStream << static_cast<quint32>(originalImageData_.size());
+  qint64 imageOffset = outFile.pos();
+  bool imageWritten = originalImageData_.writeTo(&outFile);
+  if (!imageWritten && outFile.error() == QFileDevice::NoError) {
+    // the original image data couldn't be read, so replace the (partial)
+    // image section with the decoded image
+    qWarning() << "Failed to read the original image data for" <<
+      projectFilename_ << "- saving the decoded image instead";
+    originalImageData_.setData(::pngData(originalImage_));
+    if (outFile.seek(headerOffset)) {
+      dataStream << static_cast<quint32>(originalImageData_.size());
+      imageOffset = outFile.pos();
+      imageWritten = originalImageData_.writeTo(&outFile) &&
+        outFile.resize(outFile.pos());
+    }
+  }
+  if (!imageWritten) {
+    const QString error = outFile.errorString();
+    outFile.cancelWriting();
+    QMessageBox::critical(activeWindow(), tr("Save failed"),
+                          tr("Sorry, the original image couldn't be written "
+                             "to %1 (%2), so the project wasn't saved (%1 "
+                             "hasn't been changed).")
+                          .arg(projectFilename_).arg(error));
+    return false;
+  }
+  if (!outFile.commit()) {
+    QMessageBox::critical(activeWindow(), tr("Save failed"),
+                          tr("Sorry, the project couldn't be written to %1 "
+                             "(%2), so it wasn't saved (%1 hasn't been "
+                             "changed).")
+                          .arg(projectFilename_).arg(outFile.errorString()));
+    return false;
+  }
+  // use the saved copy from now on
+  originalImageData_.setFile(projectFilename_, imageOffset,
+                             originalImageData_.size());
   setWindowTitles(QFileInfo(projectFilename_).fileName());
   activeWindow()->showTemporaryStatusMessage(tr("Saved project to %1")
                                              .arg(projectFilename_));
   updateRecentFiles(projectFilename_, recentProjectsMenu_);
+  return true;
 }
 
 void windowManager::openProject() {
@@ -525,6 +638,7 @@ static void reportCorruptProject(const QString& message) {
 
 bool windowManager::openProject(const QString& projectFile) {
 
+  const traceSpan span("windowManager::openProject");
   QFile inFile(projectFile);
   if (!inFile.open(QIODevice::ReadOnly)) {
     QMessageBox::critical(NULL, tr("Bad project file"),
@@ -533,14 +647,12 @@ bool windowManager::openProject(const QString& projectFile) {
                           .arg(projectFile));
     return false;
   }
-  // the save file starts with xml text, so read that first
-  QTextStream textInStream(&inFile);
-  QString inString;
-  inString = textInStream.readLine() + "\n";
+  // the save file starts with xml text, so check that first
+  const QString firstLine = QString::fromUtf8(inFile.readLine());
   // (A day after the initial release I changed the program name from
   // stitch to cstitch, so check for either...)
   QRegExp rx("^<(cstitch|stitch) version=");
-  rx.indexIn(inString);
+  rx.indexIn(firstLine);
   const QString programName = rx.cap(1);
   if (programName != "cstitch" && programName != "stitch") { // uh oh
     QMessageBox::critical(NULL, tr("Bad project file"),
@@ -550,39 +662,89 @@ bool windowManager::openProject(const QString& projectFile) {
     return false;
   }
 
-  const QString endTag = "</" + programName + ">";
-  QString thisString = "";
-  do {
-    thisString = textInStream.readLine();
-    if (thisString.isNull()) {
-      // oops, we missed the closing tag and read all the way to the end of the
-      // file...
+  // make a first pass over the xml to check it, count the images we'll be
+  // restoring, and find the end of the xml (the image data follows it)
+  traceSpan step("openProject: scan xml");
+  inFile.seek(0);
+  int imageCount = 1; // one colorChooser image
+  QString projectVersion;
+  int colorCount = 0;
+  bool foundEnd = false;
+  {
+    QXmlStreamReader reader(&inFile);
+    if (reader.readNextStartElement() && programName == "cstitch") {
+      projectVersion = reader.attributes().value("version").toString();
+    }
+    int depth = 1; // inside the root element
+    while (!reader.atEnd()) {
+      reader.readNext();
+      if (reader.isStartElement()) {
+        const QStringRef name = reader.name();
+        if (depth == 1 && name == "color_count") {
+          // (reads through the end element)
+          colorCount = reader.readElementText().toInt();
+          continue;
+        }
+        ++depth;
+        if (name == "color_compare_image" || name == "square_window_image" ||
+            name == "pattern_window_image") {
+          ++imageCount;
+        }
+      }
+      else if (reader.isEndElement() && --depth == 0) {
+        foundEnd = true;
+        break;
+      }
+    }
+    if (reader.hasError() &&
+        reader.error() != QXmlStreamReader::PrematureEndOfDocumentError) {
       QMessageBox::critical(NULL, tr("Bad project file"),
                             tr("Sorry, %1 appears to be corrupted "
-                               "(diagnostic: can't find end of data)")
+                               "(diagnostic: parse failed)")
                             .arg(projectFile));
       return false;
     }
-    inString += thisString + "\n";
-  } while (thisString != endTag);
-
-  QDomDocument doc;
-  const bool xmlLoadSuccess = doc.setContent(inString);
-  if (!xmlLoadSuccess) {
+  }
+  // the reader's offsets count characters, not bytes, so find the byte
+  // offset of the end of the xml from the closing tag's line, which is the
+  // only line that starts with it
+  qint64 xmlEnd = -1;
+  if (foundEnd) {
+    const QByteArray endTag = "</" + programName.toLatin1() + ">";
+    inFile.seek(0);
+    while (!inFile.atEnd()) {
+      if (inFile.readLine().startsWith(endTag)) {
+        xmlEnd = inFile.pos();
+        break;
+      }
+    }
+  }
+  if (xmlEnd == -1) {
+    // oops, we missed the closing tag and read all the way to the end of the
+    // file...
     QMessageBox::critical(NULL, tr("Bad project file"),
                           tr("Sorry, %1 appears to be corrupted "
-                             "(diagnostic: parse failed)")
+                             "(diagnostic: can't find end of data)")
                           .arg(projectFile));
     return false;
   }
-  // a blank line between the xml and the image
-  inString += textInStream.readLine() + "\n";
 
-  // now read the binary data image
-  inFile.seek(inString.length());
+  // skip the blank line between the xml and the image
+  step.restart("openProject: decode image");
+  inFile.seek(xmlEnd);
+  inFile.readLine();
+  // the image is stored as a QByteArray: a 32 bit size and then the
+  // image file's bytes, which we decode straight from the file and then
+  // map rather than read
   QDataStream imageStream(&inFile);
+  quint32 imageSize = 0;
+  imageStream >> imageSize;
+  const qint64 imageOffset = inFile.pos();
   QImage newImage;
-  imageStream >> newImage;
+  if (imageStream.status() == QDataStream::Ok && imageSize != 0xffffffff &&
+      imageOffset + imageSize <= inFile.size()) {
+    newImage = QImageReader(&inFile).read();
+  }
   if (newImage.isNull()) {
     QMessageBox::critical(NULL, tr("Bad project file"),
                           tr("Sorry, %1 appears to be corrupted "
@@ -590,20 +752,13 @@ bool windowManager::openProject(const QString& projectFile) {
                           .arg(projectFile));
     return false;
   }
-  inFile.seek(inString.length());
-  QDataStream imageData(&inFile);
-  QByteArray imageByteArray;
-  imageData >> imageByteArray;
+  inFile.close();
 
   // hide everything except progress meters while we regenerate this project
   hideWindows_ = true;
   hideWindows();
 
   // how many total images are we restoring?
-  int imageCount = 1; // one colorChooser image
-  imageCount += doc.elementsByTagName("color_compare_image").size();
-  imageCount += doc.elementsByTagName("square_window_image").size();
-  imageCount += doc.elementsByTagName("pattern_window_image").size();
   groupProgressDialog progressMeter(imageCount);
   progressMeter.setMinimumDuration(2000);
   progressMeter.setWindowModality(Qt::WindowModal);
@@ -612,72 +767,45 @@ bool windowManager::openProject(const QString& projectFile) {
   altMeter::setGroupMeter(&progressMeter);
   
   // read the project version number
-  setProjectVersion(::getElementAttribute(doc, "cstitch", "version"));
-  reset(newImage, imageByteArray);
+  step.restart("openProject: color chooser");
+  setProjectVersion(projectVersion);
+  reset(newImage, projectFile, imageOffset, imageSize);
 
   //// colorChooser
   colorChooser_.window()->setNewImage(newImage);
   progressMeter.bumpCount();
 
-  //// colorCompare
-  QDomElement colorCompareElement =
-    doc.elementsByTagName("color_compare").item(0).toElement();
-  if (!colorCompareElement.isNull()) {
-    colorChooser* colorChooserObject = colorChooser_.window();
-    QDomNodeList compareImagesList(colorCompareElement.
-                                   elementsByTagName("color_compare_image"));
-    for (int i = 0, size = compareImagesList.size(); i < size; ++i) {
-      QDomElement thisCompareElement(compareImagesList.item(i).toElement());
-      const int hiddenColorCompareIndex = colorChooserObject->
-        recreateImage(colorCompareSaver(thisCompareElement));
-      progressMeter.bumpCount();
-      //// squareWindow
-      colorCompare* colorCompareObject = colorCompareWindow_.window();
-      QDomNodeList squareImagesList(thisCompareElement.
-                                    elementsByTagName("square_window_image"));
-      if (!squareImagesList.isEmpty()) {
-        for (int ii = 0, iiSize = squareImagesList.size(); ii < iiSize; ++ii) {
-          QDomElement thisSquareElement(squareImagesList.item(ii).toElement());
-          const int hiddenSquareImageIndex = colorCompareObject->
-            recreateImage(squareWindowSaver(thisSquareElement));
-          progressMeter.bumpCount();
-          squareWindow* squareWindowObject = squareWindow_.window();
-          //// patternWindow
-          // restore this square image's children before restoring its history
-          // (the children may have their own different histories)
-          QDomNodeList
-            patternImageList(thisSquareElement.
-                             elementsByTagName("pattern_window_image"));
-          if (!patternImageList.isEmpty()) {
-            for (int iii = 0, iiiSize = patternImageList.size();
-                 iii < iiiSize; ++iii) {
-              QDomElement thisPatternElement(patternImageList.item(iii).
-                                             toElement());
-              squareWindowObject->
-                recreatePatternImage(patternWindowSaver(thisPatternElement));
-              patternWindow_.window()->updateHistory(thisPatternElement);
-              progressMeter.bumpCount();
-            }
+  // now make the restoring pass over the xml; global settings come before
+  // the images but are restored after them
+  step.restart("openProject: restore images");
+  inFile.seek(0);
+  QXmlStreamReader reader(&inFile);
+  QDomDocument globalsDoc;
+  QDomElement windowGlobals;
+  if (reader.readNextStartElement()) {
+    while (reader.readNextStartElement()) {
+      if (reader.name() == "global_settings") {
+        windowGlobals = ::readDomElement(&reader, &globalsDoc);
+      }
+      //// colorCompare
+      else if (reader.name() == "color_compare") {
+        while (reader.readNextStartElement()) {
+          if (reader.name() == "color_compare_image") {
+            restoreColorCompareImage(&reader, &progressMeter);
           }
-          squareWindowObject->updateImageHistory(thisSquareElement);
-          // if this image was only created so that one of its children could be
-          // recreated, remove it (its data has already been stored away)
-          if (hiddenSquareImageIndex != -1) {
-            squareWindowObject->removeImage(hiddenSquareImageIndex);
+          else {
+            reader.skipCurrentElement();
           }
         }
       }
-      // if this image was only created so that one of its children could be
-      // recreated, remove it (its data has already been stored away)
-      if (hiddenColorCompareIndex != -1) {
-        colorCompareObject->removeImage(hiddenColorCompareIndex);
+      else {
+        reader.skipCurrentElement();
       }
     }
   }
 
   //// restore window wide settings that are independent of a particular image
-  QDomElement windowGlobals(doc.elementsByTagName("global_settings").
-                            item(0).toElement());
+  step.restart("openProject: restore settings");
   if (colorChooserAction_->isEnabled() && colorChooser_.window()) {
     const QString error =
       colorChooser_.window()->updateCurrentSettings(windowGlobals);
@@ -707,8 +835,7 @@ bool windowManager::openProject(const QString& projectFile) {
       reportCorruptProject(error);
     }
   }
-  // read the image number of colors (before the reset)
-  const int colorCount = ::getElementText(doc, "color_count").toInt();
+  // set the image number of colors (read before the reset)
   originalImageColorCount_ = colorCount;
   // call while hideWindows_ (if colorCount wasn't 0 it won't be recalculated)
   startOriginalImageColorCount();
@@ -720,12 +847,161 @@ bool windowManager::openProject(const QString& projectFile) {
   return true;
 }
 
-void windowManager::reset(const QImage& image, const QByteArray& byteArray,
+void windowManager::
+restoreColorCompareImage(QXmlStreamReader* reader,
+                         groupProgressDialog* progressMeter) {
+
+  const traceSpan span("windowManager::restoreColorCompareImage");
+  // the image's own fields come before its children, so recreate it once
+  // we reach its children (or its end)
+  QHash<QString, QString> fields;
+  bool recreated = false;
+  int hiddenColorCompareIndex = -1;
+  while (reader->readNextStartElement()) {
+    if (reader->name() == "square_window") {
+      if (!recreated) {
+        hiddenColorCompareIndex = colorChooser_.window()->
+          recreateImage(colorCompareSaver(fields));
+        progressMeter->bumpCount();
+        recreated = true;
+      }
+      //// squareWindow
+      while (reader->readNextStartElement()) {
+        if (reader->name() == "square_window_image") {
+          restoreSquareWindowImage(reader, progressMeter);
+        }
+        else {
+          reader->skipCurrentElement();
+        }
+      }
+    }
+    else {
+      fields.insert(reader->name().toString(),
+                    reader->readElementText(QXmlStreamReader::
+                                            IncludeChildElements));
+    }
+  }
+  if (!recreated) {
+    hiddenColorCompareIndex = colorChooser_.window()->
+      recreateImage(colorCompareSaver(fields));
+    progressMeter->bumpCount();
+  }
+  // if this image was only created so that one of its children could be
+  // recreated, remove it (its data has already been stored away)
+  if (hiddenColorCompareIndex != -1) {
+    colorCompareWindow_.window()->removeImage(hiddenColorCompareIndex);
+  }
+}
+
+void windowManager::
+restoreSquareWindowImage(QXmlStreamReader* reader,
+                         groupProgressDialog* progressMeter) {
+
+  const traceSpan span("windowManager::restoreSquareWindowImage");
+  QHash<QString, QString> fields;
+  QList<historyItemPtr> backHistory;
+  QList<historyItemPtr> forwardHistory;
+  bool recreated = false;
+  int hiddenSquareImageIndex = -1;
+  while (reader->readNextStartElement()) {
+    if (reader->name() == "history") {
+      while (reader->readNextStartElement()) {
+        if (reader->name() == "backward_history") {
+          backHistory = historyItem::xmlToHistoryList(reader);
+        }
+        else if (reader->name() == "forward_history") {
+          forwardHistory = historyItem::xmlToHistoryList(reader);
+        }
+        else {
+          reader->skipCurrentElement();
+        }
+      }
+    }
+    else if (reader->name() == "pattern_window") {
+      if (!recreated) {
+        hiddenSquareImageIndex = colorCompareWindow_.window()->
+          recreateImage(squareWindowSaver(fields));
+        progressMeter->bumpCount();
+        recreated = true;
+      }
+      //// patternWindow
+      // restore this square image's children before restoring its history
+      // (the children may have their own different histories)
+      while (reader->readNextStartElement()) {
+        if (reader->name() == "pattern_window_image") {
+          restorePatternWindowImage(reader, progressMeter);
+        }
+        else {
+          reader->skipCurrentElement();
+        }
+      }
+    }
+    else {
+      fields.insert(reader->name().toString(),
+                    reader->readElementText(QXmlStreamReader::
+                                            IncludeChildElements));
+    }
+  }
+  if (!recreated) {
+    hiddenSquareImageIndex = colorCompareWindow_.window()->
+      recreateImage(squareWindowSaver(fields));
+    progressMeter->bumpCount();
+  }
+  squareWindow* squareWindowObject = squareWindow_.window();
+  squareWindowObject->updateImageHistory(fields.value("index").toInt(),
+                                         fields.value("tool_floss_type"),
+                                         backHistory, forwardHistory);
+  // if this image was only created so that one of its children could be
+  // recreated, remove it (its data has already been stored away)
+  if (hiddenSquareImageIndex != -1) {
+    squareWindowObject->removeImage(hiddenSquareImageIndex);
+  }
+}
+
+void windowManager::
+restorePatternWindowImage(QXmlStreamReader* reader,
+                          groupProgressDialog* progressMeter) {
+
+  const traceSpan span("windowManager::restorePatternWindowImage");
+  QHash<QString, QString> fields;
+  QList<historyItemPtr> squareHistory;
+  QDomDocument historyDoc;
+  QDomElement symbolHistory;
+  while (reader->readNextStartElement()) {
+    if (reader->name() == "square_history") {
+      while (reader->readNextStartElement()) {
+        if (reader->name() == "backward_history") {
+          squareHistory = historyItem::xmlToHistoryList(reader);
+        }
+        else {
+          reader->skipCurrentElement();
+        }
+      }
+    }
+    else if (reader->name() == "symbol_history") {
+      symbolHistory = ::readDomElement(reader, &historyDoc);
+    }
+    else {
+      fields.insert(reader->name().toString(),
+                    reader->readElementText(QXmlStreamReader::
+                                            IncludeChildElements));
+    }
+  }
+  squareWindow_.window()->
+    recreatePatternImage(patternWindowSaver(fields, squareHistory));
+  patternWindow_.window()->updateHistory(fields.value("index").toInt(),
+                                         symbolHistory);
+  progressMeter->bumpCount();
+}
+
+void windowManager::reset(const QImage& image, const QString& imageFile,
+                          qint64 imageOffset, qint64 imageSize,
                           const QString& imageName) {
 
   projectFilename_ = QString();
   originalImage_ = image;
-  originalImageData_ = byteArray;
+  originalPyramid_ = imagePyramid(image, true);
+  originalImageData_.setFile(imageFile, imageOffset, imageSize);
   originalImageName_ = imageName;
   originalImageColorCount_ = 0;
 
@@ -897,12 +1173,10 @@ bool windowManager::openNewImage(const QString& imageFile) {
     QMessageBox::warning(NULL, "Image load failed", errorString);
     return false;
   }
-  QFile fileDevice(imageFile);
-  fileDevice.open(QIODevice::ReadOnly);
-  QByteArray byteArray(fileDevice.readAll());
-  const QString imageName = QFileInfo(imageFile).fileName();
+  const QFileInfo imageInfo(imageFile);
+  const QString imageName = imageInfo.fileName();
   
-  reset(newImage, byteArray, imageName);
+  reset(newImage, imageFile, 0, imageInfo.size(), imageName);
   setProjectVersion(programVersion_);
   ::showAndRaise(colorChooser_.window());
   colorChooser_.window()->setNewImage(newImage);
@@ -1069,6 +1343,75 @@ void windowManager::autoShowQuickHelp(bool show) {
   activeWindow()->showQuickHelp(show);
 }
 
+void windowManager::recordTrace(bool record) {
+
+  if (record) {
+    const QString traceFile =
+      QFileDialog::getSaveFileName(activeWindow(), tr("Save timing trace"),
+                                   "./cstitch_trace.json",
+                                   tr("Trace files (*.json)\n"
+                                      "All files (*)"));
+    if (traceFile.isEmpty()) {
+      recordTraceAction_->blockSignals(true);
+      recordTraceAction_->setChecked(false);
+      recordTraceAction_->blockSignals(false);
+      return;
+    }
+    tracer::start(traceFile);
+    activeWindow()->showTemporaryStatusMessage(tr("Recording a timing "
+                                                  "trace to %1")
+                                               .arg(traceFile));
+  }
+  else {
+    writeTrace();
+  }
+}
+
+void windowManager::writeTrace() {
+
+  const QString traceFile = tracer::fileName();
+  if (!tracer::stop()) {
+    QMessageBox::warning(activeWindow(), tr("Trace not saved"),
+                         tr("Sorry, the timing trace couldn't be written "
+                            "to %1").arg(traceFile));
+  }
+}
+
+memoryUsage windowManager::originalImageMemory() const {
+
+  memoryUsage usage;
+  usage.add(tr("Image"), memoryUsage::imageBytes(originalImage_));
+  usage.add(tr("Zoom levels"), originalPyramid_.levelBytes());
+  usage.add(tr("Image file data"), originalImageData_.memoryBytes());
+  return usage;
+}
+
+void windowManager::showMemoryUsage() {
+
+  memoryUsage usage;
+  usage.add(tr("Original image"), originalImageMemory());
+  if (colorCompareWindow_.window()) {
+    usage.append(tr("Color compare: "),
+                 colorCompareWindow_.window()->imagesMemory());
+  }
+  if (squareWindow_.window()) {
+    usage.append(tr("Square compare: "),
+                 squareWindow_.window()->imagesMemory());
+  }
+  if (patternWindow_.window()) {
+    usage.append(tr("Pattern: "),
+                 patternWindow_.window()->imagesMemory());
+  }
+  // shared by all pattern images (so it overlaps their symbols)
+  usage.add(tr("Pattern symbol cache"), symbolChooser::cacheBytes());
+  const qint64 labTableBytes = paletteRegistry::labTableBytes();
+  if (labTableBytes > 0) {
+    usage.add(tr("Lab color match tables"), labTableBytes);
+  }
+  QMessageBox::information(activeWindow(), tr("Memory usage"),
+                           usage.toString());
+}
+
 QList<imageZoomWindow*> windowManager::constructedWidgets() const {
 
   QList<imageZoomWindow*> returnList;
@@ -1117,11 +1460,93 @@ QString windowManager::getWindowTitle() const {
 
 void windowManager::setProjectVersion(const QString& projectVersion) {
 
+  // background previews use the processor and data sources
+  if (colorChooser_.window()) {
+    colorChooser_.window()->stopPreview();
+  }
   projectVersion_ = projectVersion;
   versionProcessor::setProcessor(projectVersion_);
   colorMatcher::resetDataSources();
 }
 
+int windowManager::runBenchmarks(const QStringList& imageFiles,
+                                 const QString& outputFile) {
+
+  setProjectVersion(programVersion_);
+  return ::runBenchmarks(imageFiles, outputFile, programVersion_);
+}
+
+int windowManager::runKernelCheck(const QString& fileName, bool record) {
+
+  setProjectVersion(programVersion_);
+  return record ? ::recordKernelOutputs(fileName) :
+    ::checkKernelOutputs(fileName);
+}
+
+// return project file <data> without its date line (the one thing a
+// save always changes)
+static QByteArray withoutProjectDate(QByteArray data) {
+
+  const int dateStart = data.indexOf("\n  <date>");
+  if (dateStart != -1) {
+    const int dateEnd = data.indexOf('\n', dateStart + 1);
+    data.remove(dateStart, dateEnd - dateStart);
+  }
+  return data;
+}
+
+int windowManager::runProjectCheck(const QString& fileName) {
+
+  QFile original(fileName);
+  if (!original.open(QIODevice::ReadOnly)) {
+    qWarning() << "Project check: can't open" << fileName;
+    return 1;
+  }
+  const QByteArray originalData = ::withoutProjectDate(original.readAll());
+  original.close();
+  if (!openProject(fileName)) {
+    return 1;
+  }
+
+  QTemporaryFile savedFile(QDir::temp().filePath("cstitch_XXXXXX.xst"));
+  if (!savedFile.open()) {
+    qWarning() << "Project check: can't create a temporary file";
+    return 1;
+  }
+  savedFile.close();
+  projectFilename_ = savedFile.fileName();
+  if (!saveAs(projectFilename_)) {
+    return 1;
+  }
+  // (saveAs maps the image from the saved file now, so let it go before
+  // we're done with the file)
+  originalImageData_.detach();
+  if (!savedFile.open()) {
+    qWarning() << "Project check: can't read" << savedFile.fileName();
+    return 1;
+  }
+  const QByteArray savedData = ::withoutProjectDate(savedFile.readAll());
+
+  QTextStream out(stdout);
+  if (savedData == originalData) {
+    out << "Project check: " << fileName << " round trips (" <<
+      originalData.size() << " bytes)" << endl;
+    return 0;
+  }
+  int firstDifference = 0;
+  while (firstDifference < savedData.size() &&
+         firstDifference < originalData.size() &&
+         savedData[firstDifference] == originalData[firstDifference]) {
+    ++firstDifference;
+  }
+  QTextStream(stderr) << "Project check: " << fileName <<
+    " was saved differently starting at byte " << firstDifference <<
+    " (ignoring the date line):\n  original: " <<
+    originalData.mid(firstDifference, 60) << "\n  saved: " <<
+    savedData.mid(firstDifference, 60) << endl;
+  return 1;
+}
+
 void windowManager::updateRecentFiles(const QString& file,
                                       fileListMenu* menu) {
 
@@ -1134,6 +1559,12 @@ void windowManager::quit() {
   QSettings settings("cstitch", "cstitch");
   settings.setValue("recent_images", recentImagesMenu_->files());
   settings.setValue("recent_projects", recentProjectsMenu_->files());
+  if (colorChooser_.window()) {
+    colorChooser_.window()->stopPreview();
+  }
+  if (tracer::on()) {
+    writeTrace();
+  }
 }
 
 void windowManager::openRecentImage(const QString& imageFile) {
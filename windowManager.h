@@ -26,6 +26,8 @@
 #include <QtWidgets/QWidget>
 #include <QtWidgets/QAction>
 
+#include "fileBytes.h"
+#include "imagePyramid.h"
 #include "windowSavers.h"
 
 class triC;
@@ -37,6 +39,10 @@ class patternWindow;
 class colorCompare;
 class imageZoomWindow;
 class fileListMenu;
+class groupProgressDialog;
+class QXmlStreamReader;
+class QStringList;
+class memoryUsage;
 
 // a simple class for keeping track of a count that starts at 1 and
 // increments on each call of ()
@@ -191,13 +197,20 @@ class windowManager : public QObject {
   // set it as the new image in colorChooser
   void openNewImage();
   // A new <image> has been loaded, so reset/delete all old data to prepare for
-  // new data.
-  void reset(const QImage& image, const QByteArray& byteArray,
+  // new data.  The image's raw data is the <imageSize> bytes at <imageOffset>
+  // in <imageFile>.
+  void reset(const QImage& image, const QString& imageFile,
+             qint64 imageOffset, qint64 imageSize,
              const QString& imageName = QString());
   // call only when the program is definitely quitting
   void quit();
   // there is no non-const access to the original image
   const QImage& originalImage() const { return originalImage_; }
+  // the original image along with its scaled down levels, for display
+  const imagePyramid& originalPyramid() const { return originalPyramid_; }
+  // return the memory held by the original image, its zoom levels and
+  // its raw data
+  memoryUsage originalImageMemory() const;
   int getOriginalImageColorCount();
   // sets *w and *h to the width and height of the frame of windows in the
   // current environment (or 0s if the colorChooser object doesn't exist
@@ -207,12 +220,26 @@ class windowManager : public QObject {
     programVersion_ = version;
   }
   QString getProgramVersion() const { return programVersion_; }
+  // time the image processing kernels using the current program version's
+  // processing (see benchmark.h) and return the process exit code
+  int runBenchmarks(const QStringList& imageFiles, const QString& outputFile);
+  // record the kernel outputs to <fileName> if <record>, otherwise check
+  // the kernel outputs against those recorded in <fileName> (see
+  // kernelCheck.h); return the process exit code
+  int runKernelCheck(const QString& fileName, bool record);
+  // open the project <fileName>, save it again and check that the saved
+  // file has the same bytes as the original (other than the save date);
+  // return the process exit code
+  int runProjectCheck(const QString& fileName);
   QString getProjectVersion() const { return projectVersion_; }
 
  public slots:
   // save all current data to file
   void save();
-  void saveAs(const QString projectFilename = QString());
+  // save all current data to <projectFilename> (or to a file specified by
+  // the user if it's null); return false if the save failed, in which
+  // case any existing file is left as it was
+  bool saveAs(const QString projectFilename = QString());
   // reload a saved project from file specified by user
   void openProject();
 
@@ -277,9 +304,25 @@ class windowManager : public QObject {
   // <projectFile> must be a path that exists.  Return true if the project
   // opens successfully, otherwise return false.
   bool openProject(const QString& projectFile);
+  // openProject helpers: restore the image whose start element <reader> is
+  // on, along with its children, leaving <reader> on its end element
+  void restoreColorCompareImage(QXmlStreamReader* reader,
+                                groupProgressDialog* progressMeter);
+  void restoreSquareWindowImage(QXmlStreamReader* reader,
+                                groupProgressDialog* progressMeter);
+  void restorePatternWindowImage(QXmlStreamReader* reader,
+                                 groupProgressDialog* progressMeter);
+  // stop tracing and write the trace, warning the user on failure
+  void writeTrace();
 
  private slots:
   void autoShowQuickHelp(bool show);
+  // start recording a timing trace (after asking for the file to write it
+  // to) if <record>, otherwise stop and write the trace
+  void recordTrace(bool record);
+  // pop up a summary of the memory held by the original image and by
+  // every other image in each of the main windows
+  void showMemoryUsage();
   // hide the current main window and display the main window contained
   // in <action>'s data
   void displayActionWindow(QAction* action);
@@ -294,8 +337,12 @@ class windowManager : public QObject {
   void openRecentProject(const QString& projectFile);
 
  private:
-  QByteArray originalImageData_; // the user's original image (as raw data)
+  // the user's original image (as raw data, usually mapped from the image
+  // or project file it came from)
+  fileBytes originalImageData_;
   QImage originalImage_; // the user's original image (as a QImage)
+  // shares originalImage_
+  imagePyramid originalPyramid_;
   // the filename of the original image (excluding the path); empty if we've
   // loaded a project
   QString originalImageName_;
@@ -348,6 +395,10 @@ class windowManager : public QObject {
   // the checkbox common to all windows that determines whether quick
   // help is auto shown or not
   QAction* autoShowQuickHelp_;
+  // turns timing traces (see trace.h) on and off; shared by all windows
+  QAction* recordTraceAction_;
+  // shows the memory summary (see showMemoryUsage); shared by all windows
+  QAction* memoryUsageAction_;
 
   // true if we don't want any of the main windows visible
   // ONLY used during restore
@@ -19,82 +19,85 @@
 
 #include "windowSavers.h"
 
+
 #include "xmlUtility.h"
 
-colorCompareSaver::colorCompareSaver(const QDomElement& xmlElement)
-  : modeSaver(::getElementText(xmlElement, "index").toInt(), 0),
-    creationMode_(::getElementText(xmlElement, "creation_mode")),
-    colors_(::loadColorListFromText(::getElementText(xmlElement,
-                                                     "color_list"))) {
+colorCompareSaver::
+colorCompareSaver(const QHash<QString, QString>& xmlFields)
+  : modeSaver(xmlFields.value("index").toInt(), 0),
+    creationMode_(xmlFields.value("creation_mode")),
+    colors_(::loadColorListFromText(xmlFields.value("color_list"))),
+    // (older projects don't have a metric and were all rgb)
+    metric_(colorDistance::stringToMetric(xmlFields.value("color_metric"))) {
 
-  const bool hidden = ::stringToBool(::getElementText(xmlElement, "hidden"));
+  const bool hidden = ::stringToBool(xmlFields.value("hidden"));
   setHidden(hidden);
 }
 
-QDomElement colorCompareSaver::toXml(QDomDocument* doc) const {
-
-  QDomElement element = doc->createElement("color_compare_image");
-  ::appendTextElement(doc, "index", QString::number(index()), &element);
-  const QString hiddenString = ::boolToString(hidden());
-  ::appendTextElement(doc, "hidden", hiddenString, &element);
-  ::appendTextElement(doc, "creation_mode", creationMode_, &element);
-  ::appendColorList(doc, colors_, &element);
-
-  return element;
+bool colorCompareSaver::startXml(xmlWriter* writer) const {
+
+  writer->writeStartElement("color_compare_image");
+  writer->writeTextElement("index", QString::number(index()));
+  writer->writeTextElement("hidden", ::boolToString(hidden()));
+  writer->writeTextElement("creation_mode", creationMode_);
+  // (only non-rgb metrics are written so that rgb projects stay byte for
+  // byte the same as they were before metrics existed)
+  if (metric_ != metricRgb) {
+    writer->writeTextElement("color_metric",
+                             colorDistance::metricToString(metric_));
+  }
+  ::writeColorList(writer, colors_);
+  return true;
 }
 
-squareWindowSaver::squareWindowSaver(const QDomElement& xmlElement)
-  : modeSaver(::getElementText(xmlElement, "index").toInt(),
-              ::getElementText(xmlElement, "parent_index").toInt()),
-    creationMode_(::getElementText(xmlElement, "creation_mode")),
-    squareDimension_(::getElementText(xmlElement,
-                                      "square_dimension").toInt()) {
+squareWindowSaver::
+squareWindowSaver(const QHash<QString, QString>& xmlFields)
+  : modeSaver(xmlFields.value("index").toInt(),
+              xmlFields.value("parent_index").toInt()),
+    creationMode_(xmlFields.value("creation_mode")),
+    squareDimension_(xmlFields.value("square_dimension").toInt()) {
 
-  bool hidden = ::stringToBool(::getElementText(xmlElement, "hidden"));
+  bool hidden = ::stringToBool(xmlFields.value("hidden"));
   setHidden(hidden);
 }
 
-QDomElement squareWindowSaver::toXml(QDomDocument* doc) const {
+bool squareWindowSaver::startXml(xmlWriter* writer) const {
 
-  QDomElement element = doc->createElement("square_window_image");
-  ::appendTextElement(doc, "index", QString::number(index()), &element);
-  const QString hiddenString = ::boolToString(hidden());
-  ::appendTextElement(doc, "hidden", hiddenString, &element);
-  ::appendTextElement(doc, "parent_index", QString::number(parentIndex()),
-                      &element);
-  ::appendTextElement(doc, "creation_mode", creationMode_, &element);
-  ::appendTextElement(doc, "square_dimension",
-                      QString::number(squareDimension_), &element);
-
-  return element;
+  writer->writeStartElement("square_window_image");
+  writer->writeTextElement("index", QString::number(index()));
+  writer->writeTextElement("hidden", ::boolToString(hidden()));
+  writer->writeTextElement("parent_index", QString::number(parentIndex()));
+  writer->writeTextElement("creation_mode", creationMode_);
+  writer->writeTextElement("square_dimension",
+                           QString::number(squareDimension_));
+  return true;
 }
 
-patternWindowSaver::patternWindowSaver(const QDomElement& xmlElement)
-  : modeSaver(::getElementText(xmlElement, "index").toInt(),
-              ::getElementText(xmlElement, "parent_index").toInt()),
-    squareDimension_(::getElementText(xmlElement, "square_dimension").toInt()) {
-
-  QDomNode historyNode =
-    squareHistory_.importNode(xmlElement.
-                              firstChildElement("square_history"),
-                              true);
-  squareHistory_.appendChild(historyNode);
-}
-
-QDomElement patternWindowSaver::toXml(QDomDocument* doc) const {
-
-  QDomElement element = doc->createElement("pattern_window_image");
-  ::appendTextElement(doc, "index", QString::number(index()), &element);
-  const QString hiddenString = ::boolToString(hidden());
-  ::appendTextElement(doc, "hidden", hiddenString, &element);
-  ::appendTextElement(doc, "parent_index", QString::number(parentIndex()),
-                      &element);
-  ::appendTextElement(doc, "square_dimension",
-                      QString::number(squareDimension_), &element);
-  QDomNode historyNode =
-    doc->importNode(squareHistory_.firstChildElement("square_history"),
-                    true);
-  element.appendChild(historyNode);
-
-  return element;
+patternWindowSaver::
+patternWindowSaver(const QHash<QString, QString>& xmlFields,
+                   const QList<historyItemPtr>& squareHistory)
+  : modeSaver(xmlFields.value("index").toInt(),
+              xmlFields.value("parent_index").toInt()),
+    squareDimension_(xmlFields.value("square_dimension").toInt()),
+    squareHistory_(squareHistory) {}
+
+bool patternWindowSaver::startXml(xmlWriter* writer) const {
+
+  writer->writeStartElement("pattern_window_image");
+  writer->writeTextElement("index", QString::number(index()));
+  writer->writeTextElement("hidden", ::boolToString(hidden()));
+  writer->writeTextElement("parent_index", QString::number(parentIndex()));
+  writer->writeTextElement("square_dimension",
+                           QString::number(squareDimension_));
+  writer->writeStartElement("square_history");
+  writer->writeStartElement("backward_history");
+  writer->writeAttribute("count", QString::number(squareHistory_.size()));
+  for (int i = 0, size = squareHistory_.size(); i < size; ++i) {
+    if (!squareHistory_[i]->toXml(writer)) {
+      return false;
+    }
+  }
+  writer->writeEndElement(); // backward_history
+  writer->writeEndElement(); // square_history
+  return true;
 }
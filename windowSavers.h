@@ -20,11 +20,14 @@
 #ifndef WINDOWSAVERS_H
 #define WINDOWSAVERS_H
 
+#include <QtCore/QHash>
 #include <QtCore/QVector>
 
 #include <QtXml/QDomDocument>
 
+#include "colorDistance.h"
 #include "triC.h"
+#include "squareToolHistories.h"
 
 // Hold a record of an index, its parent index, and any children indices.
 // Hidden means this index has been deleted in some way, but we still need
@@ -58,7 +61,10 @@ class parentChildren {
 };
 
 // interface for the specific mode saver classes; the basic function is
-// to take in data via a constructor and write it out via toXml
+// to take in data via a constructor and write it out via startXml, which
+// leaves the saver's element open so that the caller can write the
+// saver's children before ending it (startXml returns false if some of
+// the saver's data couldn't be read back)
 class modeSaver : public parentChildren {
 
  public:
@@ -66,8 +72,7 @@ class modeSaver : public parentChildren {
   modeSaver(int thisIndex, int parentIndex)
     : parentChildren(thisIndex, parentIndex) {}
   virtual ~modeSaver() {}
-  virtual QDomElement
-    toXml(QDomDocument* doc) const = 0;
+  virtual bool startXml(xmlWriter* writer) const = 0;
   int index() const { return thisIndex(); }
   int parent() const { return parentIndex(); }
 };
@@ -75,20 +80,24 @@ class modeSaver : public parentChildren {
 class colorCompareSaver : public modeSaver {
 
  public:
-  colorCompareSaver() : creationMode_(""), colors_() {}
+  colorCompareSaver() : creationMode_(""), colors_(), metric_(metricRgb) {}
   colorCompareSaver(int thisIndex, int parentIndex,
                     const QString& creationMode,
-                    const QVector<triC>& colors)
+                    const QVector<triC>& colors, colorMetric metric)
     : modeSaver(thisIndex, parentIndex), creationMode_(creationMode),
-    colors_(colors) {}
-  explicit colorCompareSaver(const QDomElement& xmlElement);
+    colors_(colors), metric_(metric) {}
+  // <xmlFields> are the saver's text elements keyed by element name
+  explicit colorCompareSaver(const QHash<QString, QString>& xmlFields);
   QString creationMode() const { return creationMode_; }
   const QVector<triC>& colors() const { return colors_; }
-  QDomElement toXml(QDomDocument* doc) const;
+  // the metric the image's colors were matched with
+  colorMetric metric() const { return metric_; }
+  bool startXml(xmlWriter* writer) const;
 
  private:
   QString creationMode_;
   QVector<triC> colors_;
+  colorMetric metric_;
 };
 
 class squareWindowSaver : public modeSaver {
@@ -99,10 +108,10 @@ class squareWindowSaver : public modeSaver {
                     const QString& creationMode, int squareDimension)
     : modeSaver(thisIndex, parentIndex), creationMode_(creationMode),
     squareDimension_(squareDimension) {}
-  explicit squareWindowSaver(const QDomElement& xmlElement);
+  explicit squareWindowSaver(const QHash<QString, QString>& xmlFields);
   QString creationMode() const { return creationMode_; }
   int squareDimension() const { return squareDimension_; }
-  QDomElement toXml(QDomDocument* doc) const;
+  bool startXml(xmlWriter* writer) const;
 
  private:
   QString creationMode_;
@@ -113,17 +122,21 @@ class patternWindowSaver : public modeSaver {
 
  public:
   patternWindowSaver() : modeSaver() {}
+  // <squareHistory> is the back history of the square image at the time
+  // the pattern was created (the items are shared with the square image,
+  // and only serialized if the project is saved)
   patternWindowSaver(int thisIndex, int parentIndex, int squareDimension,
-                    const QDomDocument& xmlSquareHistory)
+                     const QList<historyItemPtr>& squareHistory)
     : modeSaver(thisIndex, parentIndex), squareDimension_(squareDimension),
-    squareHistory_(xmlSquareHistory) {}
-  explicit patternWindowSaver(const QDomElement& xmlElement);
-  QDomElement toXml(QDomDocument* doc) const;
-  QDomDocument squareHistory() const { return squareHistory_; }
+    squareHistory_(squareHistory) {}
+  patternWindowSaver(const QHash<QString, QString>& xmlFields,
+                     const QList<historyItemPtr>& squareHistory);
+  bool startXml(xmlWriter* writer) const;
+  QList<historyItemPtr> squareHistory() const { return squareHistory_; }
 
  private:
   int squareDimension_;
-  QDomDocument squareHistory_;
+  QList<historyItemPtr> squareHistory_;
 };
 
 #endif
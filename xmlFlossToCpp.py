@@ -15,8 +15,8 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #
 
-# Turns a dmc.xml file in kxstitch format into cpp code ready to insert into
-# colorLists.cpp
+# Turns a dmc.xml file in kxstitch format into floss table entries ready to
+# insert into a floss table in colorLists.cpp
 
 import xml.etree.ElementTree as ET
 
@@ -30,7 +30,7 @@ class Floss():
         self.blue = None
 
     def toCpp(self):
-        return ("  dmc.push_back(floss(%s, \"%s\", triC(%d,%d,%d)));" %
+        return ("  {%s, \"%s\", %d, %d, %d}," %
                 (self.code, self.name, self.red, self.green, self.blue))
 
 floss_list = list()
@@ -21,6 +21,9 @@
 
 #include <QtCore/QDebug>
 
+#include <QtCore/QIODevice>
+#include <QtCore/QXmlStreamReader>
+
 #include <QtXml/QDomDocument>
 #include <QtXml/QDomElement>
 
@@ -59,10 +62,223 @@ QString getElementAttribute(const QDomDocument& doc,
   return doc.firstChildElement(elementName).attribute(attributeName);
 }
 
-void appendColorList(QDomDocument* doc, const QVector<triC>& colors,
-                     QDomElement* appendee,
-                     const QString& attributeName,
-                     const QString& attributeValue) {
+// return true if <text> might be escaped differently than as is
+static bool mayNeedEscaping(const QString& text) {
+
+  for (int i = 0, size = text.size(); i < size; ++i) {
+    const ushort c = text[i].unicode();
+    if (c < 0x20 || c > 0x7e || c == '<' || c == '>' || c == '&' ||
+        c == '"' || c == '\'') {
+      return true;
+    }
+  }
+  return false;
+}
+
+// return <text> escaped the way QDomDocument::toString escapes it as text
+// (or as an attribute value if <attribute>)
+static QString domEscaped(const QString& text, bool attribute) {
+
+  if (!::mayNeedEscaping(text)) {
+    return text;
+  }
+  QDomDocument doc;
+  QDomElement element(doc.createElement("x"));
+  doc.appendChild(element);
+  if (attribute) {
+    element.setAttribute("a", text);
+    // <x a="..."/>
+    const QString xml = doc.toString(-1);
+    return xml.mid(6, xml.size() - 9);
+  }
+  else {
+    element.appendChild(doc.createTextNode(text));
+    // <x>...</x>
+    const QString xml = doc.toString(-1);
+    return xml.mid(3, xml.size() - 7);
+  }
+}
+
+xmlWriter::xmlWriter(QIODevice* device)
+  : stream_(device), startTagOpen_(false), emptyElementOpen_(false),
+    afterText_(false) {}
+
+QString xmlWriter::indent() const {
+
+  return QString(2 * openElements_.size(), ' ');
+}
+
+void xmlWriter::finishStartTag(bool textFollows) {
+
+  if (emptyElementOpen_) {
+    stream_ << "/>\n";
+  }
+  else if (startTagOpen_) {
+    stream_ << '>';
+    if (!textFollows) {
+      stream_ << '\n';
+    }
+  }
+  startTagOpen_ = false;
+  emptyElementOpen_ = false;
+}
+
+void xmlWriter::writeStartElement(const QString& name) {
+
+  finishStartTag(false);
+  stream_ << indent() << '<' << name;
+  openElements_.push_back(name);
+  startTagOpen_ = true;
+  afterText_ = false;
+}
+
+void xmlWriter::writeEmptyElement(const QString& name) {
+
+  finishStartTag(false);
+  stream_ << indent() << '<' << name;
+  startTagOpen_ = true;
+  emptyElementOpen_ = true;
+  afterText_ = false;
+}
+
+void xmlWriter::writeAttribute(const QString& name, const QString& value) {
+
+  if (!startTagOpen_) {
+    qWarning() << "xmlWriter: attribute" << name << "outside a start tag";
+    return;
+  }
+  stream_ << ' ' << name << "=\"" << ::domEscaped(value, true) << '"';
+}
+
+void xmlWriter::writeCharacters(const QString& text) {
+
+  finishStartTag(true);
+  stream_ << ::domEscaped(text, false);
+  afterText_ = true;
+}
+
+void xmlWriter::writeEndElement() {
+
+  if (emptyElementOpen_) {
+    finishStartTag(false);
+  }
+  if (openElements_.isEmpty()) {
+    qWarning() << "xmlWriter: end element without a start element";
+    return;
+  }
+  const QString name = openElements_.takeLast();
+  if (startTagOpen_) { // no children
+    stream_ << "/>\n";
+    startTagOpen_ = false;
+  }
+  else {
+    if (!afterText_) {
+      stream_ << indent();
+    }
+    stream_ << "</" << name << ">\n";
+  }
+  afterText_ = false;
+}
+
+void xmlWriter::writeTextElement(const QString& name, const QString& text) {
+
+  writeStartElement(name);
+  writeCharacters(text);
+  writeEndElement();
+}
+
+void xmlWriter::writeEndDocument() {
+
+  finishStartTag(false);
+  while (!openElements_.isEmpty()) {
+    writeEndElement();
+  }
+  stream_.flush();
+}
+
+void writeTextElement(xmlWriter* writer, const QString& elementName,
+                      const QString& text, const QString& attributeName,
+                      const QString& attributeValue) {
+
+  writer->writeStartElement(elementName);
+  if (attributeName != "") {
+    writer->writeAttribute(attributeName, attributeValue);
+  }
+  writer->writeCharacters(text);
+  writer->writeEndElement();
+}
+
+void writeDomElementStart(xmlWriter* writer,
+                          const QDomElement& element) {
+
+  writer->writeStartElement(element.tagName());
+  const QDomNamedNodeMap attributes = element.attributes();
+  for (int i = 0, size = attributes.count(); i < size; ++i) {
+    const QDomAttr attribute = attributes.item(i).toAttr();
+    writer->writeAttribute(attribute.name(), attribute.value());
+  }
+  for (QDomNode child = element.firstChild(); !child.isNull();
+       child = child.nextSibling()) {
+    if (child.isElement()) {
+      ::writeDomElement(writer, child.toElement());
+    }
+    else if (child.isText()) {
+      writer->writeCharacters(child.toText().data());
+    }
+  }
+}
+
+void writeDomElement(xmlWriter* writer, const QDomElement& element) {
+
+  if (!element.hasChildNodes()) {
+    writer->writeEmptyElement(element.tagName());
+    const QDomNamedNodeMap attributes = element.attributes();
+    for (int i = 0, size = attributes.count(); i < size; ++i) {
+      const QDomAttr attribute = attributes.item(i).toAttr();
+      writer->writeAttribute(attribute.name(), attribute.value());
+    }
+    return;
+  }
+  ::writeDomElementStart(writer, element);
+  writer->writeEndElement();
+}
+
+QDomElement readDomElement(QXmlStreamReader* reader, QDomDocument* doc) {
+
+  QDomElement element(doc->createElement(reader->name().toString()));
+  const QXmlStreamAttributes attributes = reader->attributes();
+  for (int i = 0, size = attributes.size(); i < size; ++i) {
+    element.setAttribute(attributes[i].name().toString(),
+                         attributes[i].value().toString());
+  }
+  while (!reader->atEnd()) {
+    reader->readNext();
+    if (reader->isStartElement()) {
+      element.appendChild(::readDomElement(reader, doc));
+    }
+    else if (reader->isEndElement()) {
+      break;
+    }
+    // (QDomDocument::setContent drops whitespace only text as well)
+    else if (reader->isCharacters() && !reader->isWhitespace()) {
+      element.appendChild(doc->createTextNode(reader->text().toString()));
+    }
+  }
+  return element;
+}
+
+QHash<QString, QString> readTextElements(QXmlStreamReader* reader) {
+
+  QHash<QString, QString> elements;
+  while (reader->readNextStartElement()) {
+    const QString name = reader->name().toString();
+    elements.insert(name, reader->
+                    readElementText(QXmlStreamReader::IncludeChildElements));
+  }
+  return elements;
+}
+
+QString colorListToString(const QVector<triC>& colors) {
 
   QString colorListString;
   for (int i = 0, size = colors.size(); i < size; ++i) {
@@ -71,6 +287,21 @@ void appendColorList(QDomDocument* doc, const QVector<triC>& colors,
   if (colorListString != "") { // remove trailing ;
     colorListString.remove(colorListString.size() - 1, 1);
   }
+  return colorListString;
+}
+
+void writeColorList(xmlWriter* writer, const QVector<triC>& colors) {
+
+  ::writeTextElement(writer, "color_list", ::colorListToString(colors),
+                     "count", QString::number(colors.size()));
+}
+
+void appendColorList(QDomDocument* doc, const QVector<triC>& colors,
+                     QDomElement* appendee,
+                     const QString& attributeName,
+                     const QString& attributeValue) {
+
+  const QString colorListString = ::colorListToString(colors);
   QDomElement element(doc->createElement("color_list"));
   element.appendChild(doc->createTextNode(colorListString));
   appendee->appendChild(element);
@@ -92,15 +323,13 @@ QString coordinateListToString(const QVector<pairOfInts>& coordinates) {
   return coordinateListString;
 }
 
-void appendCoordinatesList(QDomDocument* doc,
-                           const QVector<pairOfInts>& coordinates,
-                           QDomElement* appendee) {
+void writeCoordinatesList(xmlWriter* writer,
+                          const QVector<pairOfInts>& coordinates) {
 
   const QString coordinateListString =
     ::coordinateListToString(coordinates);
-  ::appendTextElement(doc, "coordinate_list", coordinateListString,
-                      appendee, "count",
-                      QString::number(coordinates.size()));
+  ::writeTextElement(writer, "coordinate_list", coordinateListString,
+                     "count", QString::number(coordinates.size()));
 }
 
 QString coordinatesToString(const pairOfInts& p) {
@@ -138,8 +367,7 @@ QVector<pairOfInts> xmlToCoordinatesList(const QString& list) {
   return returnList;
 }
 
-void appendPixelList(QDomDocument* doc, const QVector<pixel>& pixels,
-                     QDomElement* appendee) {
+void writePixelList(xmlWriter* writer, const QVector<pixel>& pixels) {
 
   QString pixelListString;
   for (int i = 0, size = pixels.size(); i < size; ++i) {
@@ -148,8 +376,8 @@ void appendPixelList(QDomDocument* doc, const QVector<pixel>& pixels,
   if (pixelListString != "") { // remove trailing ;
     pixelListString.chop(1);
   }
-  ::appendTextElement(doc, "pixel_list", pixelListString, appendee,
-                      "count", QString::number(pixels.size()));
+  ::writeTextElement(writer, "pixel_list", pixelListString,
+                     "count", QString::number(pixels.size()));
 }
 
 QString pixelToString(const pixel& p) {
@@ -189,9 +417,8 @@ QVector<pixel> xmlToPixelList(const QString& list) {
   return returnList;
 }
 
-void appendHistoryPixelList(QDomDocument* doc,
-                            const QVector<historyPixel>& pixels,
-                            QDomElement* appendee) {
+void writeHistoryPixelList(xmlWriter* writer,
+                           const QVector<historyPixel>& pixels) {
 
   QString pixelListString;
   for (int i = 0, size = pixels.size(); i < size; ++i) {
@@ -200,13 +427,12 @@ void appendHistoryPixelList(QDomDocument* doc,
   if (pixelListString != "") { // remove trailing ;
     pixelListString.remove(pixelListString.size() - 1, 1);
   }
-  ::appendTextElement(doc, "history_pixel_list", pixelListString, appendee,
-                      "count", QString::number(pixels.size()));
+  ::writeTextElement(writer, "history_pixel_list", pixelListString,
+                     "count", QString::number(pixels.size()));
 }
 
-void appendColorChangeHistoryList(QDomDocument* doc,
-                                  const QList<colorChange>& colorChanges,
-                                  QDomElement* appendee) {
+void writeColorChangeHistoryList(xmlWriter* writer,
+                                 const QList<colorChange>& colorChanges) {
 
   QString colorChangeString;
   for (int i = 0, size = colorChanges.size(); i < size; ++i) {
@@ -217,9 +443,8 @@ void appendColorChangeHistoryList(QDomDocument* doc,
   if (colorChangeString != "") { // remove trailing "+"
     colorChangeString.remove(colorChangeString.size() - 1, 1);
   }
-  ::appendTextElement(doc, "color_change_list", colorChangeString,
-                      appendee, "count",
-                      QString::number(colorChanges.size()));
+  ::writeTextElement(writer, "color_change_list", colorChangeString,
+                     "count", QString::number(colorChanges.size()));
 }
 
 QList<colorChange> xmlToColorChangeList(const QString& list) {
@@ -314,12 +539,11 @@ QString flossSetToString(const QSet<flossColor>& colors) {
   return returnString;
 }
 
-void appendFlossList(QDomDocument* doc, const QSet<flossColor>& colors,
-                     QDomElement* appendee) {
+void writeFlossList(xmlWriter* writer, const QSet<flossColor>& colors) {
 
   const QString xmlString = ::flossSetToString(colors);
-  ::appendTextElement(doc, "floss_list", xmlString, appendee, "count",
-                      QString::number(colors.size()));
+  ::writeTextElement(writer, "floss_list", xmlString, "count",
+                     QString::number(colors.size()));
 }
 
 QSet<flossColor> xmlStringToFlossSet(const QString& string) {
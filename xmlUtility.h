@@ -20,7 +20,10 @@
 #ifndef XMLUTILITY_H
 #define XMLUTILITY_H
 
+#include <QtCore/QHash>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QTextStream>
 
 #include "triC.h"
 #include "floss.h"
@@ -31,6 +34,57 @@ class historyPixel;
 class colorChange;
 class QDomDocument;
 class QDomElement;
+class QXmlStreamReader;
+class QIODevice;
+
+// xmlWriter streams xml to a device in exactly the format
+// QDomDocument::toString(2) uses, so that a project file's bytes are the
+// same whether we stream it or build a document for it (as versions
+// before 0.9.8 did).  The interface is the subset of QXmlStreamWriter's
+// that we need.
+//
+//// Implementation notes
+//
+// Text and attribute values with nothing that could need escaping are
+// written as is; anything else is escaped by serializing it in a scratch
+// QDomDocument, so the escaping is QDom's own.
+// An element is assumed to contain either text or elements, never both
+// (which is true of all of our data).
+class xmlWriter {
+
+ public:
+  explicit xmlWriter(QIODevice* device);
+  void writeStartElement(const QString& name);
+  // add an attribute to the element just started
+  void writeAttribute(const QString& name, const QString& value);
+  void writeCharacters(const QString& text);
+  void writeEndElement();
+  // an element containing a text node with <text>, the way
+  // appendTextElement creates it (so empty text gives <name></name>)
+  void writeTextElement(const QString& name, const QString& text);
+  // an element with no children at all (<name/>); attributes can be
+  // added until the next write
+  void writeEmptyElement(const QString& name);
+  // flush everything written to the device
+  void writeEndDocument();
+
+ private:
+  // close an open start tag, which ends its line unless text follows
+  void finishStartTag(bool textFollows);
+  // indentation for an element at the current depth
+  QString indent() const;
+
+ private:
+  QTextStream stream_;
+  // names of the elements we're inside of
+  QStringList openElements_;
+  // true if the last start tag written hasn't been closed yet
+  bool startTagOpen_;
+  // true if the open start tag is an empty element's
+  bool emptyElementOpen_;
+  // true if the last thing written was text
+  bool afterText_;
+};
 
 void appendTextElement(QDomDocument* doc, const QString& elementName,
                        const QString& text, QDomElement* appendee,
@@ -45,27 +99,43 @@ QString getElementAttribute(const QDomDocument& doc,
                             const QString& elementName,
                             const QString& attributeName);
 
+// the xmlWriter version of appendTextElement
+void writeTextElement(xmlWriter* writer, const QString& elementName,
+                      const QString& text,
+                      const QString& attributeName = QString(),
+                      const QString& attributeValue = QString());
+// write <element>'s start tag, attributes and children (elements and text
+// only) to <writer>, leaving <element> open
+void writeDomElementStart(xmlWriter* writer,
+                          const QDomElement& element);
+// writeDomElementStart, then end <element>
+void writeDomElement(xmlWriter* writer, const QDomElement& element);
+// read the element <reader> is on (through its end tag) into a new
+// element of <doc> and return it
+QDomElement readDomElement(QXmlStreamReader* reader, QDomDocument* doc);
+// read the element <reader> is on (through its end tag) and return the
+// text of each of its child elements, keyed by child element name
+QHash<QString, QString> readTextElements(QXmlStreamReader* reader);
+
 void appendColorList(QDomDocument* doc, const QVector<triC>& colors,
                      QDomElement* appendee,
                      const QString& attributeName = QString(),
                      const QString& attributeValue = QString());
-void appendCoordinatesList(QDomDocument* doc,
-                           const QVector<pairOfInts>& coordinates,
-                           QDomElement* appendee);
+void writeColorList(xmlWriter* writer, const QVector<triC>& colors);
+QString colorListToString(const QVector<triC>& colors);
+void writeCoordinatesList(xmlWriter* writer,
+                          const QVector<pairOfInts>& coordinates);
 QVector<pairOfInts> xmlToCoordinatesList(const QString& list);
 
-void appendPixelList(QDomDocument* doc, const QVector<pixel>& pixels,
-                     QDomElement* appendee);
+void writePixelList(xmlWriter* writer, const QVector<pixel>& pixels);
 QVector<pixel> xmlToPixelList(const QString& list);
 
-void appendHistoryPixelList(QDomDocument* doc,
-                            const QVector<historyPixel>& pixels,
-                            QDomElement* appendee);
+void writeHistoryPixelList(xmlWriter* writer,
+                           const QVector<historyPixel>& pixels);
 QVector<historyPixel> xmlToHistoryPixelList(const QString& list);
 
-void appendColorChangeHistoryList(QDomDocument* doc,
-                                  const QList<colorChange>& colorChanges,
-                                  QDomElement* appendee);
+void writeColorChangeHistoryList(xmlWriter* writer,
+                                 const QList<colorChange>& colorChanges);
 QList<colorChange> xmlToColorChangeList(const QString& list);
 
 QString rgbToString(const triC& color);
@@ -77,8 +147,7 @@ flossColor xmlStringToFlossColor(const QString& string);
 
 QString flossSetToString(const QSet<flossColor>& colors);
 QSet<flossColor> xmlStringToFlossSet(const QString& string);
-void appendFlossList(QDomDocument* doc, const QSet<flossColor>& colors,
-                     QDomElement* appendee);
+void writeFlossList(xmlWriter* writer, const QSet<flossColor>& colors);
 
 inline QString boolToString(bool b) { return b ? "true" : "false"; }
 inline bool stringToBool(const QString& s) {